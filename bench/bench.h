@@ -0,0 +1,103 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../week 4/hmi_system.h"
+
+// One benchmark at one problem size. The benchmark builds its fixture for
+// size(), then calls measure() with the number of operations the timed body
+// performs; the harness turns that into ns per operation over the repeats.
+class BenchRun {
+public:
+    BenchRun(std::size_t size, int repeats) : problemSize(size), repeatCount(repeats) {}
+
+    std::size_t size() const { return problemSize; }
+
+    template <typename Body>
+    void measure(std::uint64_t operations, Body&& body) {
+        measure(operations, std::forward<Body>(body), [] {});
+    }
+
+    // reset runs untimed before every repeat, e.g. to restore unsorted input
+    template <typename Body, typename Reset>
+    void measure(std::uint64_t operations, Body&& body, Reset&& reset) {
+        operationCount = std::max<std::uint64_t>(operations, 1);
+        reset();
+        body();  // warm-up
+        for (int i = 0; i < repeatCount; ++i) {
+            reset();
+            auto start = std::chrono::steady_clock::now();
+            body();
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            samples.push_back(std::chrono::duration<double, std::nano>(elapsed).count() / operationCount);
+        }
+    }
+
+    // Extra result reported alongside the timings, e.g. a compression ratio
+    void report(const std::string& name, double value) { extraMetrics.emplace_back(name, value); }
+
+    std::uint64_t operations() const { return operationCount; }
+    const std::vector<double>& samplesNs() const { return samples; }
+    const std::vector<std::pair<std::string, double>>& metrics() const { return extraMetrics; }
+
+private:
+    std::size_t problemSize;
+    int repeatCount;
+    std::uint64_t operationCount = 1;
+    std::vector<double> samples;
+    std::vector<std::pair<std::string, double>> extraMetrics;
+};
+
+using BenchFunction = void (*)(BenchRun&);
+
+struct BenchEntry {
+    std::string name;
+    BenchFunction function;
+};
+
+inline std::vector<BenchEntry>& benchRegistry() {
+    static std::vector<BenchEntry> registry;
+    return registry;
+}
+
+// Declared at namespace scope in each benchmark file to add it to the suite
+struct BenchRegistrar {
+    BenchRegistrar(const char* name, BenchFunction function) {
+        benchRegistry().push_back({name, function});
+    }
+};
+
+// Stream buffer that drops everything; benchmarks point the output sink at it
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int ch) override { return ch; }
+    std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+// Observer that does the minimum a real widget would: remember the mode it was given
+class CountingObserver : public ModeObserver {
+public:
+    void update(Mode mode) override {
+        lastMode = mode;
+        ++updates;
+    }
+
+    Mode lastMode = Mode::Day;
+    unsigned long updates = 0;
+};
+
+// Keeps the optimizer from discarding a computed value
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+#endif // BENCH_H
@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../output_sink.h"
+#include "bench.h"
+
+// Usage: hmi_bench [--sizes 100,1000,10000] [--repeats 5] [--filter text] [--out file.json] [--list]
+//
+// Every registered benchmark runs once per size and the results are written
+// as JSON (stdout by default), one record per benchmark and size, so two runs
+// can be diffed or compared by a script.
+
+struct Options {
+    std::vector<std::size_t> sizes = {100, 1000, 10000};
+    int repeats = 5;
+    std::string filter;
+    std::string outPath;
+    bool list = false;
+};
+
+// Empty if any item is not a positive integer; benchmarks need at least one element
+std::vector<std::size_t> parseSizes(const std::string& text) {
+    std::vector<std::size_t> sizes;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (item.empty()) {
+            continue;
+        }
+        char* end = nullptr;
+        unsigned long long size = std::strtoull(item.c_str(), &end, 10);
+        if (*end != '\0' || size < 1 || item[0] == '-') {
+            return {};
+        }
+        sizes.push_back(size);
+    }
+    return sizes;
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--sizes" && hasValue) {
+            options.sizes = parseSizes(argv[++i]);
+            if (options.sizes.empty()) {
+                std::cerr << "--sizes takes a comma-separated list of positive integers\n";
+                return false;
+            }
+        } else if (arg == "--repeats" && hasValue) {
+            options.repeats = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        } else if (arg == "--out" && hasValue) {
+            options.outPath = argv[++i];
+        } else if (arg == "--list") {
+            options.list = true;
+        } else {
+            std::cerr << "Unknown or incomplete option: " << arg << "\n"
+                      << "Usage: hmi_bench [--sizes 100,1000,10000] [--repeats 5] [--filter text]"
+                      << " [--out file.json] [--list]\n";
+            return false;
+        }
+    }
+    return !options.sizes.empty();
+}
+
+struct Summary {
+    double min;
+    double median;
+    double mean;
+    double max;
+};
+
+Summary summarize(std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    double total = 0;
+    for (double sample : samples) {
+        total += sample;
+    }
+    std::size_t middle = samples.size() / 2;
+    double median = samples.size() % 2 == 1 ? samples[middle] : (samples[middle - 1] + samples[middle]) / 2;
+    return {samples.front(), median, total / samples.size(), samples.back()};
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    std::vector<BenchEntry> entries = benchRegistry();
+    std::sort(entries.begin(), entries.end(), [](const BenchEntry& a, const BenchEntry& b) { return a.name < b.name; });
+
+    if (options.list) {
+        for (const auto& entry : entries) {
+            std::cout << entry.name << "\n";
+        }
+        return 0;
+    }
+
+    // Console output from the code under test goes nowhere while we measure
+    NullBuffer nullBuffer;
+    std::ostream nullStream(&nullBuffer);
+    OutputSink::instance().setTarget(nullStream);
+
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(3);
+    json << "{\n  \"repeats\": " << options.repeats << ",\n  \"benchmarks\": [";
+    bool first = true;
+
+    for (const auto& entry : entries) {
+        if (!options.filter.empty() && entry.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+        for (std::size_t size : options.sizes) {
+            std::cerr << entry.name << " size=" << size << "\n";
+            BenchRun run(size, options.repeats);
+            entry.function(run);
+            OutputSink::instance().flush();
+            if (run.samplesNs().empty()) {
+                continue;
+            }
+
+            Summary summary = summarize(run.samplesNs());
+            json << (first ? "\n" : ",\n");
+            first = false;
+            json << "    {\"name\": \"" << entry.name << "\", \"size\": " << size
+                 << ", \"operations\": " << run.operations()
+                 << ", \"ns_per_op\": {\"min\": " << summary.min << ", \"median\": " << summary.median
+                 << ", \"mean\": " << summary.mean << ", \"max\": " << summary.max << "}"
+                 << ", \"ops_per_sec\": " << 1e9 / summary.median;
+            if (!run.metrics().empty()) {
+                json << ", \"metrics\": {";
+                for (std::size_t i = 0; i < run.metrics().size(); ++i) {
+                    json << (i == 0 ? "" : ", ") << "\"" << run.metrics()[i].first << "\": " << run.metrics()[i].second;
+                }
+                json << "}";
+            }
+            json << "}";
+        }
+    }
+    json << "\n  ]\n}\n";
+
+    OutputSink::instance().setTarget(std::cout);
+
+    if (options.outPath.empty()) {
+        std::cout << json.str();
+    } else {
+        std::ofstream out(options.outPath);
+        if (!out) {
+            std::cerr << "Cannot write " << options.outPath << "\n";
+            return 1;
+        }
+        out << json.str();
+    }
+    return 0;
+}
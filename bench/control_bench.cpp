@@ -0,0 +1,258 @@
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../week 4/versioned_store.h"
+#include "bench.h"
+
+// The week 4 algorithm tasks each define this struct inside their own program;
+// it is repeated here (with internal linkage, so it cannot clash with the
+// Control class of the HMI patterns) to time the same std algorithm paths.
+namespace {
+
+struct Control {
+    int id;             // Unique ID
+    std::string type;   // "button" or "slider"
+    std::string state;  // "visible", "invisible", or "disabled"
+
+    // Define how to compare controls by ID
+    bool operator<(const Control& other) const {
+        return id < other.id;
+    }
+
+    bool operator==(const Control& other) const {
+        return id == other.id && type == other.type && state == other.state;
+    }
+};
+
+const char* const controlStates[] = {"visible", "invisible", "disabled"};
+
+// count controls with ids firstId, firstId + step, ... in shuffled order
+std::vector<Control> makeControls(std::size_t count, int firstId = 1, int step = 1, unsigned seed = 1) {
+    std::mt19937 rng(seed);
+    std::vector<Control> controls;
+    controls.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        controls.push_back({firstId + static_cast<int>(i) * step, rng() % 2 == 0 ? "button" : "slider",
+                            controlStates[rng() % 3]});
+    }
+    std::shuffle(controls.begin(), controls.end(), rng);
+    return controls;
+}
+
+std::vector<Control> sortedControls(std::size_t count, int firstId, int step) {
+    std::vector<Control> controls = makeControls(count, firstId, step);
+    std::sort(controls.begin(), controls.end());
+    return controls;
+}
+
+// std::find_if by id, as in week 4 task1
+void benchFindById(BenchRun& run) {
+    std::vector<Control> controls = makeControls(run.size());
+    std::vector<int> wanted(64);
+    std::mt19937 rng(3);
+    for (int& id : wanted) {
+        id = 1 + static_cast<int>(rng() % run.size());
+    }
+
+    run.measure(wanted.size(), [&] {
+        for (int id : wanted) {
+            auto found = std::find_if(controls.begin(), controls.end(), [id](const Control& ctrl) {
+                return ctrl.id == id;
+            });
+            doNotOptimize(found);
+        }
+    });
+}
+
+// std::count_if on the state string, as in week 4 task1
+void benchCountVisible(BenchRun& run) {
+    std::vector<Control> controls = makeControls(run.size());
+
+    run.measure(controls.size(), [&] {
+        auto visible = std::count_if(controls.begin(), controls.end(), [](const Control& ctrl) {
+            return ctrl.state == "visible";
+        });
+        doNotOptimize(visible);
+    });
+}
+
+// std::sort and std::stable_sort by id, as in week 4 task4
+void benchSort(BenchRun& run) {
+    const std::vector<Control> shuffled = makeControls(run.size());
+    std::vector<Control> controls;
+
+    run.measure(shuffled.size(), [&] { std::sort(controls.begin(), controls.end()); },
+                [&] { controls = shuffled; });
+}
+
+void benchStableSort(BenchRun& run) {
+    const std::vector<Control> shuffled = makeControls(run.size());
+    std::vector<Control> controls;
+
+    run.measure(shuffled.size(), [&] { std::stable_sort(controls.begin(), controls.end()); },
+                [&] { controls = shuffled; });
+}
+
+// std::lower_bound on the sorted list, as in week 4 task4
+void benchBinarySearch(BenchRun& run) {
+    std::vector<Control> controls = sortedControls(run.size(), 1, 1);
+    std::vector<Control> keys = makeControls(256, 1, static_cast<int>(std::max<std::size_t>(run.size() / 256, 1)));
+
+    run.measure(keys.size(), [&] {
+        for (const Control& key : keys) {
+            doNotOptimize(std::lower_bound(controls.begin(), controls.end(), key));
+        }
+    });
+}
+
+// std::merge and std::inplace_merge of two sorted halves, as in week 4 task4
+void benchMerge(BenchRun& run) {
+    std::vector<Control> evens = sortedControls(run.size() / 2, 2, 2);
+    std::vector<Control> odds = sortedControls(run.size() - run.size() / 2, 1, 2);
+    std::vector<Control> merged(evens.size() + odds.size());
+
+    run.measure(merged.size(), [&] {
+        std::merge(evens.begin(), evens.end(), odds.begin(), odds.end(), merged.begin());
+    });
+}
+
+void benchInplaceMerge(BenchRun& run) {
+    std::vector<Control> halves = sortedControls(run.size() / 2, 2, 2);
+    std::vector<Control> odds = sortedControls(run.size() - run.size() / 2, 1, 2);
+    std::size_t split = halves.size();
+    halves.insert(halves.end(), odds.begin(), odds.end());
+    std::vector<Control> controls;
+
+    run.measure(halves.size(),
+                [&] { std::inplace_merge(controls.begin(), controls.begin() + split, controls.end()); },
+                [&] { controls = halves; });
+}
+
+// std::set_union and std::set_intersection of two lists sharing half their ids
+void benchSetUnion(BenchRun& run) {
+    std::vector<Control> first = sortedControls(run.size(), 1, 1);
+    std::vector<Control> second = sortedControls(run.size(), static_cast<int>(run.size() / 2) + 1, 1);
+    std::vector<Control> result;
+    result.reserve(first.size() + second.size());
+
+    run.measure(first.size() + second.size(), [&] {
+        result.clear();
+        std::set_union(first.begin(), first.end(), second.begin(), second.end(), std::back_inserter(result));
+    });
+}
+
+void benchSetIntersection(BenchRun& run) {
+    std::vector<Control> first = sortedControls(run.size(), 1, 1);
+    std::vector<Control> second = sortedControls(run.size(), static_cast<int>(run.size() / 2) + 1, 1);
+    std::vector<Control> result;
+    result.reserve(run.size());
+
+    run.measure(first.size() + second.size(), [&] {
+        result.clear();
+        std::set_intersection(first.begin(), first.end(), second.begin(), second.end(), std::back_inserter(result));
+    });
+}
+
+// Per-frame backup for undo, as in week 4 task3: keep the last second of
+// versions while a few controls change every frame
+constexpr std::size_t historyFrames = 60;
+constexpr std::size_t editsPerFrame = 4;
+
+std::vector<std::size_t> frameEdits(std::size_t count) {
+    std::mt19937 rng(5);
+    std::vector<std::size_t> edits(editsPerFrame);
+    for (std::size_t& index : edits) {
+        index = rng() % count;
+    }
+    return edits;
+}
+
+// backupControls = controls every frame; reported per frame
+void benchSnapshotFullCopy(BenchRun& run) {
+    std::vector<Control> controls = makeControls(run.size());
+    std::vector<std::size_t> edits = frameEdits(run.size());
+    std::vector<std::vector<Control>> history(historyFrames);
+    std::size_t frame = 0;
+
+    run.measure(historyFrames, [&] {
+        for (std::size_t i = 0; i < historyFrames; ++i, ++frame) {
+            history[frame % historyFrames] = controls;
+            for (std::size_t index : edits) {
+                controls[index].state = controlStates[frame % 3];
+            }
+        }
+    });
+
+    run.report("bytes_per_snapshot", sizeof(std::vector<Control>) + controls.capacity() * sizeof(Control));
+}
+
+// VersionedStore::snapshot() every frame; reported per frame
+void benchSnapshotCow(BenchRun& run) {
+    std::vector<Control> controls = makeControls(run.size());
+    VersionedStore<Control> store(controls.begin(), controls.end());
+    std::vector<std::size_t> edits = frameEdits(run.size());
+    std::vector<VersionedStore<Control>::Snapshot> history(historyFrames);
+    std::size_t frame = 0;
+
+    run.measure(historyFrames, [&] {
+        for (std::size_t i = 0; i < historyFrames; ++i, ++frame) {
+            history[frame % historyFrames] = store.snapshot();
+            for (std::size_t index : edits) {
+                store.edit(index).state = controlStates[frame % 3];
+            }
+        }
+    });
+
+    run.report("bytes_per_snapshot",
+               static_cast<double>(VersionedStore<Control>::footprintBytes(history)) / historyFrames);
+}
+
+// Diff of two consecutive frames; reported per control
+void benchSnapshotDiff(BenchRun& run) {
+    std::vector<Control> controls = makeControls(run.size());
+    VersionedStore<Control> store(controls.begin(), controls.end());
+    VersionedStore<Control>::Snapshot before = store.snapshot();
+    for (std::size_t index : frameEdits(run.size())) {
+        store.edit(index).state = "enabled";
+    }
+    VersionedStore<Control>::Snapshot after = store.snapshot();
+
+    run.measure(run.size(), [&] { doNotOptimize(VersionedStore<Control>::diff(before, after).size()); });
+}
+
+// Roll back to the previous frame and redo its edits; reported per frame
+void benchSnapshotRollback(BenchRun& run) {
+    std::vector<Control> controls = makeControls(run.size());
+    VersionedStore<Control> store(controls.begin(), controls.end());
+    std::vector<std::size_t> edits = frameEdits(run.size());
+    VersionedStore<Control>::Snapshot backup = store.snapshot();
+
+    run.measure(historyFrames, [&] {
+        for (std::size_t i = 0; i < historyFrames; ++i) {
+            store.rollback(backup);
+            for (std::size_t index : edits) {
+                store.edit(index).state = "enabled";
+            }
+        }
+    });
+}
+
+BenchRegistrar findRegistrar("controls/find_by_id", &benchFindById);
+BenchRegistrar countRegistrar("controls/count_visible", &benchCountVisible);
+BenchRegistrar sortRegistrar("controls/sort_by_id", &benchSort);
+BenchRegistrar stableSortRegistrar("controls/stable_sort_by_id", &benchStableSort);
+BenchRegistrar binarySearchRegistrar("controls/lower_bound", &benchBinarySearch);
+BenchRegistrar mergeRegistrar("controls/merge", &benchMerge);
+BenchRegistrar inplaceMergeRegistrar("controls/inplace_merge", &benchInplaceMerge);
+BenchRegistrar unionRegistrar("controls/set_union", &benchSetUnion);
+BenchRegistrar intersectionRegistrar("controls/set_intersection", &benchSetIntersection);
+BenchRegistrar fullCopyRegistrar("controls/snapshot_full_copy", &benchSnapshotFullCopy);
+BenchRegistrar cowRegistrar("controls/snapshot_cow", &benchSnapshotCow);
+BenchRegistrar diffRegistrar("controls/snapshot_diff", &benchSnapshotDiff);
+BenchRegistrar rollbackRegistrar("controls/snapshot_rollback", &benchSnapshotRollback);
+
+}  // namespace
@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../event.h"
+#include "../output_sink.h"
+#include "bench.h"
+
+// Same mix as simulateEvents(), but seeded so every run handles identical input
+static std::vector<Event> makeEvents(std::size_t count) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> position(-250, 249);
+    std::vector<Event> events;
+    events.reserve(count);
+    time_t now = time(nullptr);
+    for (std::size_t i = 0; i < count; ++i) {
+        Event::EventType type = rng() % 2 == 0 ? Event::TAP : Event::SWIPE;
+        int x = position(rng);
+        int y = position(rng);
+        events.emplace_back(type, x, y, now);
+    }
+    return events;
+}
+
+// handleEvent() over a batch, including the sink writing the formatted lines
+static void benchHandleEvent(BenchRun& run) {
+    std::vector<Event> events = makeEvents(run.size());
+
+    run.measure(events.size(), [&] {
+        for (const Event& event : events) {
+            handleEvent(event);
+        }
+        OutputSink::instance().flush();
+    });
+}
+
+// Input storm: drags arrive as runs of small same-direction swipes and
+// presses as runs of jittery taps around one point
+static std::vector<Event> makeBurstEvents(std::size_t count) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> position(-250, 249);
+    std::uniform_int_distribution<int> jitter(-3, 3);
+    std::vector<Event> events;
+    events.reserve(count);
+    time_t now = time(nullptr);
+    while (events.size() < count) {
+        std::size_t run = std::min<std::size_t>(1 + rng() % 12, count - events.size());
+        if (rng() % 2 == 0) {
+            int x = position(rng);
+            int y = position(rng);
+            for (std::size_t i = 0; i < run; ++i) {
+                events.emplace_back(Event::TAP, x + jitter(rng), y + jitter(rng), now);
+            }
+        } else {
+            int dx = rng() % 2 == 0 ? 1 + static_cast<int>(rng() % 20) : -1 - static_cast<int>(rng() % 20);
+            for (std::size_t i = 0; i < run; ++i) {
+                events.emplace_back(Event::SWIPE, dx, jitter(rng), now);
+            }
+        }
+    }
+    return events;
+}
+
+constexpr std::size_t burstQueueCapacity = 256;
+constexpr std::size_t burstArrivalsPerTick = 64;
+constexpr std::size_t burstHandledPerTick = 16;
+
+// Each tick a burst arrives and the handler gets through a fixed number of
+// events, so the queue overflows for the whole storm. Latency is measured
+// from enqueue to the end of handleEvent(); reported per arriving event.
+// Returns the most events queued at once.
+template <typename Queue>
+static std::size_t burstLoad(BenchRun& run, Queue& queue) {
+    using Clock = std::chrono::steady_clock;
+    std::vector<Event> events = makeBurstEvents(run.size() * 10);
+    std::vector<double> latenciesUs;
+    latenciesUs.reserve(events.size());
+    std::size_t peak = 0;
+
+    run.measure(events.size(), [&] {
+        latenciesUs.clear();
+        std::size_t next = 0;
+        while (next < events.size() || !queue.empty()) {
+            for (std::size_t i = 0; i < burstArrivalsPerTick && next < events.size(); ++i) {
+                queue.push(events[next++]);
+            }
+            peak = std::max(peak, queue.size());
+            for (std::size_t i = 0; i < burstHandledPerTick && !queue.empty(); ++i) {
+                Event event = queue.front();
+                Clock::time_point enqueuedAt = queue.frontEnqueuedAt();
+                queue.pop();
+                handleEvent(event);
+                latenciesUs.push_back(std::chrono::duration<double, std::micro>(Clock::now() - enqueuedAt).count());
+            }
+        }
+    }, [&] { queue.reset(); });
+
+    std::sort(latenciesUs.begin(), latenciesUs.end());
+    run.report("p99_latency_us", latenciesUs.empty() ? 0.0 : latenciesUs[latenciesUs.size() * 99 / 100]);
+    run.report("handled", static_cast<double>(latenciesUs.size()));
+    run.report("peak_events", static_cast<double>(peak));
+    return peak;
+}
+
+static void burstBounded(BenchRun& run, OverloadPolicy policy) {
+    BoundedEventQueue queue(burstQueueCapacity, policy);
+    burstLoad(run, queue);
+    // The ring is allocated in full up front, however many events it holds
+    run.report("peak_queue_bytes", static_cast<double>(queue.memoryBytes()));
+    run.report("dropped", static_cast<double>(queue.stats().dropped));
+    run.report("coalesced", static_cast<double>(queue.stats().coalesced));
+}
+
+static void benchBurstDropOldest(BenchRun& run) {
+    burstBounded(run, OverloadPolicy::DropOldest);
+}
+
+static void benchBurstDropNewest(BenchRun& run) {
+    burstBounded(run, OverloadPolicy::DropNewest);
+}
+
+static void benchBurstCoalesce(BenchRun& run) {
+    burstBounded(run, OverloadPolicy::Coalesce);
+}
+
+// The unbounded std::queue task3 used before, for comparison
+class UnboundedEventQueue {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    void push(const Event& event) { events.push({event, Clock::now()}); }
+    bool empty() const { return events.empty(); }
+    std::size_t size() const { return events.size(); }
+    const Event& front() const { return events.front().first; }
+    Clock::time_point frontEnqueuedAt() const { return events.front().second; }
+    void pop() { events.pop(); }
+    void reset() { events = {}; }
+
+private:
+    std::queue<std::pair<Event, Clock::time_point>> events;
+};
+
+static void benchBurstUnbounded(BenchRun& run) {
+    UnboundedEventQueue queue;
+    std::size_t peak = burstLoad(run, queue);
+    run.report("peak_queue_bytes",
+               static_cast<double>(peak * sizeof(std::pair<Event, UnboundedEventQueue::Clock::time_point>)));
+}
+
+static BenchRegistrar handleEventRegistrar("events/handle_event", &benchHandleEvent);
+static BenchRegistrar burstDropOldestRegistrar("events/burst_drop_oldest", &benchBurstDropOldest);
+static BenchRegistrar burstDropNewestRegistrar("events/burst_drop_newest", &benchBurstDropNewest);
+static BenchRegistrar burstCoalesceRegistrar("events/burst_coalesce", &benchBurstCoalesce);
+static BenchRegistrar burstUnboundedRegistrar("events/burst_unbounded", &benchBurstUnbounded);
@@ -0,0 +1,75 @@
+#include <memory>
+#include <vector>
+
+#include "../week 4/control_factory.h"
+#include "bench.h"
+
+// ControlFactory::createControl(): string dispatch and one heap allocation per
+// control; the previous screen is freed untimed. Reported per control.
+static void benchFactoryHeap(BenchRun& run) {
+    std::vector<std::unique_ptr<Control>> controls;
+    controls.reserve(run.size());
+
+    run.measure(run.size(), [&] {
+        for (std::size_t i = 0; i < run.size(); ++i) {
+            controls.push_back(ControlFactory::createControl(i % 2 == 0 ? "Button" : "Slider"));
+        }
+    }, [&] { controls.clear(); });
+}
+
+// ControlScreen built one control at a time with the type picked at run time.
+// A cold screen is fresh and pays for its slabs; a warm one was cleared and
+// reuses them.
+static void measureScreenCreate(BenchRun& run, bool warm) {
+    auto screen = std::make_unique<ControlScreen>();
+
+    run.measure(run.size(), [&] {
+        for (std::size_t i = 0; i < run.size(); ++i) {
+            screen->create(i % 2 == 0 ? ControlType::Button : ControlType::Slider);
+        }
+    }, [&] {
+        if (warm) {
+            screen->clear();
+        } else {
+            screen = std::make_unique<ControlScreen>();
+        }
+    });
+}
+
+// ControlScreen built with one bulk call per control type
+static void measureScreenBulk(BenchRun& run, bool warm) {
+    auto screen = std::make_unique<ControlScreen>();
+
+    run.measure(run.size(), [&] {
+        screen->createBulk<ButtonControl>(run.size() / 2);
+        screen->createBulk<SliderControl>(run.size() - run.size() / 2);
+    }, [&] {
+        if (warm) {
+            screen->clear();
+        } else {
+            screen = std::make_unique<ControlScreen>();
+        }
+    });
+}
+
+static void benchFactoryScreenCold(BenchRun& run) {
+    measureScreenCreate(run, false);
+}
+
+static void benchFactoryScreenWarm(BenchRun& run) {
+    measureScreenCreate(run, true);
+}
+
+static void benchFactoryBulkCold(BenchRun& run) {
+    measureScreenBulk(run, false);
+}
+
+static void benchFactoryBulkWarm(BenchRun& run) {
+    measureScreenBulk(run, true);
+}
+
+static BenchRegistrar heapRegistrar("controls/factory_heap", &benchFactoryHeap);
+static BenchRegistrar screenColdRegistrar("controls/factory_screen_cold", &benchFactoryScreenCold);
+static BenchRegistrar screenWarmRegistrar("controls/factory_screen_warm", &benchFactoryScreenWarm);
+static BenchRegistrar bulkColdRegistrar("controls/factory_bulk_cold", &benchFactoryBulkCold);
+static BenchRegistrar bulkWarmRegistrar("controls/factory_bulk_warm", &benchFactoryBulkWarm);
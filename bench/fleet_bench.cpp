@@ -0,0 +1,50 @@
+#include <random>
+
+#include "../fleet_simulator.h"
+#include "../vehicle_data.h"
+#include "bench.h"
+
+// One fleet tick, size() * 100 vehicles; reported per vehicle sample
+static void benchFleetTick(BenchRun& run) {
+    WorkStealingPool pool;
+    FleetSimulator fleet(run.size() * 100, pool);
+    std::int64_t timestampMs = 0;
+
+    run.measure(fleet.vehicleCount(), [&] {
+        timestampMs += 100;
+        fleet.tick(timestampMs);
+    });
+
+    run.report("threads", pool.workerCount());
+}
+
+// VehicleData::updateData() as used by the single-vehicle task2 program
+static void benchVehicleDataUpdate(BenchRun& run) {
+    VehicleData vehicleData;
+    run.measure(run.size(), [&] {
+        for (std::size_t i = 0; i < run.size(); ++i) {
+            vehicleData.updateData();
+        }
+        doNotOptimize(vehicleData.getSpeed());
+    });
+}
+
+// The generator and distribution VehicleData used before, for comparison
+static void benchStdRandomUpdate(BenchRun& run) {
+    std::default_random_engine rng{42};
+    int speed = 0;
+    int fuel = 0;
+    int temperature = 0;
+    run.measure(run.size(), [&] {
+        for (std::size_t i = 0; i < run.size(); ++i) {
+            speed = std::uniform_int_distribution<int>(0, 200)(rng);
+            fuel = std::uniform_int_distribution<int>(0, 100)(rng);
+            temperature = std::uniform_int_distribution<int>(60, 120)(rng);
+        }
+        doNotOptimize(speed + fuel + temperature);
+    });
+}
+
+static BenchRegistrar tickRegistrar("fleet/tick", &benchFleetTick);
+static BenchRegistrar vehicleDataRegistrar("fleet/vehicle_data_update", &benchVehicleDataUpdate);
+static BenchRegistrar stdRandomRegistrar("fleet/std_random_update", &benchStdRandomUpdate);
@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../menu.h"
+#include "bench.h"
+
+// A deep menu of roughly `nodes` items: a spine of submenus where every level
+// also carries two leaf siblings, so parent searches walk a real tree.
+static std::shared_ptr<MenuItem> buildDeepMenu(std::size_t nodes, std::size_t& depth) {
+    depth = std::max<std::size_t>(nodes / 3, 1);
+    auto root = std::make_shared<MenuItem>("Main Menu");
+    auto level = root;
+    for (std::size_t i = 0; i < depth; ++i) {
+        auto next = std::make_shared<MenuItem>("Submenu " + std::to_string(i));
+        level->addSubMenu(next);
+        level->addSubMenu(std::make_shared<MenuItem>("Option A " + std::to_string(i)));
+        level->addSubMenu(std::make_shared<MenuItem>("Option B " + std::to_string(i)));
+        level = next;
+    }
+    return root;
+}
+
+// Walk from the root to the deepest submenu
+static void benchNavigateDown(BenchRun& run) {
+    std::size_t depth = 0;
+    auto root = buildDeepMenu(run.size(), depth);
+    MenuNavigator navigator(root);
+
+    run.measure(depth, [&] {
+        for (std::size_t i = 0; i < depth; ++i) {
+            navigator.navigateDown(0);
+        }
+    }, [&] { navigator.backToRoot(); });
+}
+
+// Climb back up from the deepest submenu; each step searches the tree for the parent
+static void benchNavigateUp(BenchRun& run) {
+    std::size_t depth = 0;
+    auto root = buildDeepMenu(run.size(), depth);
+    MenuNavigator navigator(root);
+    std::size_t steps = std::min<std::size_t>(depth, 16);
+
+    run.measure(steps, [&] {
+        for (std::size_t i = 0; i < steps; ++i) {
+            navigator.navigateUp();
+        }
+    }, [&] {
+        navigator.backToRoot();
+        for (std::size_t i = 0; i < depth; ++i) {
+            navigator.navigateDown(0);
+        }
+    });
+}
+
+// A bushy menu of roughly `nodes` items, eight submenus per level; always
+// at least the root and one submenu
+static std::shared_ptr<MenuItem> buildWideMenu(std::size_t nodes) {
+    nodes = std::max<std::size_t>(nodes, 2);
+    auto root = std::make_shared<MenuItem>("Main Menu");
+    std::vector<std::shared_ptr<MenuItem>> level = {root};
+    std::size_t created = 1;
+    while (created < nodes) {
+        std::vector<std::shared_ptr<MenuItem>> next;
+        for (const auto& parent : level) {
+            for (int i = 0; i < 8 && created < nodes; ++i, ++created) {
+                auto child = std::make_shared<MenuItem>("Option " + std::to_string(created));
+                parent->addSubMenu(child);
+                next.push_back(child);
+            }
+        }
+        level = std::move(next);
+    }
+    return root;
+}
+
+// Move between the root and its first few submenus, redrawing after every
+// move as task1 does; reported per redraw
+static void displayLoop(BenchRun& run, std::size_t cacheBytes) {
+    auto root = buildWideMenu(run.size());
+    MenuNavigator navigator(root, cacheBytes);
+    std::size_t menus = std::min<std::size_t>(root->subMenuItems.size(), 4);
+
+    run.measure(2 * menus, [&] {
+        for (std::size_t i = 0; i < menus; ++i) {
+            navigator.backToRoot();
+            navigator.displayCurrentMenu();
+            navigator.navigateDown(static_cast<int>(i));
+            navigator.displayCurrentMenu();
+        }
+    });
+
+    run.report("hit_rate", navigator.cacheStats().hitRate());
+    run.report("cache_bytes", static_cast<double>(navigator.cacheStats().bytes));
+}
+
+static void benchDisplayUncached(BenchRun& run) {
+    displayLoop(run, 0);
+}
+
+static void benchDisplayCached(BenchRun& run) {
+    displayLoop(run, MenuRenderCache::defaultCapacityBytes * 16);
+}
+
+// Redraw the root after adding a submenu deep in one branch; the root entry
+// is invalidated every time while the untouched branches stay cached
+static void benchDisplayAfterEdit(BenchRun& run) {
+    auto root = buildWideMenu(run.size());
+    MenuRenderCache cache(MenuRenderCache::defaultCapacityBytes * 16);
+    auto branch = root->subMenuItems.front();
+    auto leaf = branch;
+    while (!leaf->subMenuItems.empty()) {
+        leaf = leaf->subMenuItems.back();
+    }
+    const std::size_t edits = 16;
+
+    run.measure(edits, [&] {
+        for (std::size_t i = 0; i < edits; ++i) {
+            leaf->addSubMenu(std::make_shared<MenuItem>("Added"));
+            doNotOptimize(cache.render(root).size());
+            for (const auto& subMenu : root->subMenuItems) {
+                doNotOptimize(cache.render(subMenu).size());
+            }
+        }
+    });
+
+    run.report("hit_rate", cache.stats().hitRate());
+    run.report("invalidations", static_cast<double>(cache.stats().invalidations));
+}
+
+static BenchRegistrar navigateDownRegistrar("menu/navigate_down", &benchNavigateDown);
+static BenchRegistrar navigateUpRegistrar("menu/navigate_up", &benchNavigateUp);
+static BenchRegistrar displayUncachedRegistrar("menu/display_uncached", &benchDisplayUncached);
+static BenchRegistrar displayCachedRegistrar("menu/display_cached", &benchDisplayCached);
+static BenchRegistrar displayAfterEditRegistrar("menu/display_after_edit", &benchDisplayAfterEdit);
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "../output_sink.h"
+#include "../week 4/hmi_system.h"
+#include "bench.h"
+
+// Mode changes per timed body in the flip benchmarks
+static constexpr int flipsPerRun = 1000;
+
+// size() observers registered for the length of one benchmark
+class RegisteredObservers {
+public:
+    explicit RegisteredObservers(std::size_t count) : widgets(count) {
+        for (auto& widget : widgets) {
+            HMISystem::getInstance()->addObserver(&widget);
+        }
+    }
+
+    ~RegisteredObservers() {
+        for (auto& widget : widgets) {
+            HMISystem::getInstance()->removeObserver(&widget);
+        }
+    }
+
+    std::size_t size() const { return widgets.size(); }
+
+private:
+    std::vector<CountingObserver> widgets;
+};
+
+// Time notifyObservers() rounds over size() observers; reported per observer update
+static void measureFanOut(BenchRun& run) {
+    HMISystem* system = HMISystem::getInstance();
+    RegisteredObservers widgets(run.size());
+    std::size_t rounds = std::max<std::size_t>(1, 100000 / std::max<std::size_t>(run.size(), 1));
+
+    run.measure(rounds * widgets.size(), [&] {
+        for (std::size_t i = 0; i < rounds; ++i) {
+            system->notifyObservers();
+        }
+    });
+}
+
+// HMISystem::notifyObservers() fan-out on the calling thread
+static void benchNotifyObservers(BenchRun& run) {
+    measureFanOut(run);
+}
+
+// The same fan-out spread over a notification pool from the first observer on
+static void benchNotifyPooled(BenchRun& run) {
+    std::size_t poolThreads = std::max(2u, std::thread::hardware_concurrency()) - 1;
+    HMISystem::getInstance()->setNotificationThreads(poolThreads, 1);
+    measureFanOut(run);
+    HMISystem::getInstance()->setNotificationThreads(0);
+    run.report("threads", static_cast<double>(poolThreads));
+}
+
+// Rapid changeMode() flips with size() observers under one dispatch policy;
+// reported per mode change, with the notification rounds actually sent
+static void measureFlips(BenchRun& run, DispatchPolicy policy) {
+    HMISystem* system = HMISystem::getInstance();
+    RegisteredObservers widgets(run.size());
+    system->setDispatchPolicy(policy);
+    std::uint64_t flips = 0;
+    std::uint64_t rounds = 0;
+
+    run.measure(flipsPerRun, [&] {
+        std::uint64_t roundsBefore = system->notificationCount();
+        for (int i = 0; i < flipsPerRun; ++i) {
+            system->changeMode(i % 2 == 0 ? Mode::Night : Mode::Day);
+        }
+        system->flush();
+        OutputSink::instance().flush();
+        rounds += system->notificationCount() - roundsBefore;
+        flips += flipsPerRun;
+    });
+
+    system->setDispatchPolicy(DispatchPolicy::Synchronous);
+    run.report("rounds_per_flip", static_cast<double>(rounds) / flips);
+}
+
+// Synchronous delivery notifies every observer on every change
+static void benchNotifySyncFlips(BenchRun& run) {
+    measureFlips(run, DispatchPolicy::Synchronous);
+}
+
+// The asynchronous dispatcher collapses whatever piled up since its last round
+static void benchNotifyAsyncFlips(BenchRun& run) {
+    measureFlips(run, DispatchPolicy::Asynchronous);
+}
+
+static BenchRegistrar notifyRegistrar("hmi/notify_observers", &benchNotifyObservers);
+static BenchRegistrar notifyPooledRegistrar("hmi/notify_pooled", &benchNotifyPooled);
+static BenchRegistrar syncFlipsRegistrar("hmi/notify_sync_flips", &benchNotifySyncFlips);
+static BenchRegistrar asyncFlipsRegistrar("hmi/notify_async_flips", &benchNotifyAsyncFlips);
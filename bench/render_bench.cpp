@@ -0,0 +1,107 @@
+#include <array>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../output_sink.h"
+#include "../week 4/control_factory.h"
+#include "../week 4/render_pipeline.h"
+#include "bench.h"
+
+// A screen of size() widgets: mixed control types, each drawn by the 2D or 3D renderer
+class WidgetSet {
+public:
+    explicit WidgetSet(std::size_t count)
+        : flat(std::make_unique<Render2D>()), depth(std::make_unique<Render3D>()) {
+        for (std::size_t i = 0; i < count; ++i) {
+            screen.create((i * 7919) % 3 == 0 ? ControlType::Slider : ControlType::Button);
+            renderers.push_back((i / 5) % 2 == 0 ? &flat : &depth);
+        }
+    }
+
+    std::size_t size() const { return renderers.size(); }
+
+    // Two virtual calls and two console records per widget
+    void renderVirtual() const {
+        const auto& controls = screen.controls();
+        for (std::size_t i = 0; i < controls.size(); ++i) {
+            controls[i]->render();
+            renderers[i]->renderWidget();
+        }
+    }
+
+    void submit(FrameCommandBuffer& frame) const {
+        const auto& controls = screen.controls();
+        frame.clear();
+        for (std::size_t i = 0; i < controls.size(); ++i) {
+            renderers[i]->submit(*controls[i], frame);
+        }
+    }
+
+    // The batched frame must print exactly what the virtual path prints for
+    // each widget, grouped by strategy and then control type
+    bool batchedMatchesVirtual() const {
+        std::array<std::string, renderModeCount * controlTypeCount> groups;
+        OutputSink& sink = OutputSink::instance();
+        sink.setSynchronous(true);
+        std::ostringstream widgetText;
+        std::ostream& previous = sink.setTarget(widgetText);
+        const auto& controls = screen.controls();
+        for (std::size_t i = 0; i < controls.size(); ++i) {
+            widgetText.str(std::string());
+            controls[i]->render();
+            renderers[i]->renderWidget();
+            std::size_t key = static_cast<std::size_t>(renderers[i]->mode()) * controlTypeCount +
+                              typeIndex(controls[i]->type());
+            groups[key] += widgetText.str();
+        }
+        sink.setTarget(previous);
+        sink.setSynchronous(false);
+
+        std::string expected;
+        for (const auto& group : groups) {
+            expected += group;
+        }
+        FrameCommandBuffer frame;
+        std::ostringstream batched;
+        submit(frame);
+        frame.execute(batched);
+        return batched.str() == expected;
+    }
+
+private:
+    ControlScreen screen;
+    WidgetRenderer flat;
+    WidgetRenderer depth;
+    std::vector<WidgetRenderer*> renderers;
+};
+
+// One frame drawn widget by widget through the strategies; reported per widget
+static void benchFrameVirtual(BenchRun& run) {
+    WidgetSet widgets(run.size());
+
+    run.measure(widgets.size(), [&] {
+        widgets.renderVirtual();
+        OutputSink::instance().flush();
+    });
+}
+
+// One frame through FrameCommandBuffer, written as a single console record;
+// reported per widget
+static void benchFrameBatched(BenchRun& run) {
+    WidgetSet widgets(run.size());
+    FrameCommandBuffer frame;
+    frame.reserve(widgets.size());
+
+    run.measure(widgets.size(), [&] {
+        widgets.submit(frame);
+        frame.execute();
+        OutputSink::instance().flush();
+    });
+
+    run.report("matches_virtual", widgets.batchedMatchesVirtual() ? 1 : 0);
+}
+
+static BenchRegistrar frameVirtualRegistrar("render/frame_virtual", &benchFrameVirtual);
+static BenchRegistrar frameBatchedRegistrar("render/frame_batched", &benchFrameBatched);
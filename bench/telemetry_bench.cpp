@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../telemetry_log.h"
+#include "bench.h"
+
+// Uncompressed size of one sample: 64-bit timestamp plus three 32-bit signals
+static constexpr double rawSampleBytes = sizeof(std::int64_t) + 3 * sizeof(std::int32_t);
+
+// A simulated drive at 10 Hz: small timing jitter, speed as a bounded random
+// walk, fuel slowly draining and the engine warming up towards 90°C
+static std::vector<TelemetrySample> simulateDrive(std::size_t count) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> jitter(-2, 2);
+    std::uniform_int_distribution<int> accel(-3, 3);
+    std::vector<TelemetrySample> samples(count);
+    std::int64_t time = 0;
+    int speed = 0;
+    int temperature = 60;
+    for (std::size_t i = 0; i < count; ++i) {
+        time += 100 + (i % 16 == 0 ? jitter(rng) : 0);
+        speed = std::clamp(speed + accel(rng), 0, 200);
+        if (i % 50 == 0 && temperature < 90) {
+            ++temperature;
+        }
+        samples[i] = {time, speed, 100 - static_cast<int>(i / 3000 % 100), temperature};
+    }
+    return samples;
+}
+
+static std::string benchLogPath() {
+    return (std::filesystem::temp_directory_path() / "hmi_telemetry_bench.tlog").string();
+}
+
+// Streaming writer: encode and append the samples; reported per sample
+static void benchTelemetryEncode(BenchRun& run) {
+    std::vector<TelemetrySample> samples = simulateDrive(run.size() * 100);
+    if (samples.empty()) {
+        return;
+    }
+    std::string path = benchLogPath();
+    std::uint64_t bytes = 0;
+
+    run.measure(samples.size(), [&] {
+        TelemetryLogWriter writer;
+        writer.open(path, 1);
+        for (const auto& sample : samples) {
+            writer.append(sample);
+        }
+        writer.close();
+        bytes = writer.bytes();
+    });
+
+    run.report("compression_ratio", samples.size() * rawSampleBytes / bytes);
+    run.report("bytes_per_sample", static_cast<double>(bytes) / samples.size());
+    std::remove(path.c_str());
+}
+
+// Mapped reader: decode the whole log back into columns; reported per sample
+static void benchTelemetryDecode(BenchRun& run) {
+    std::vector<TelemetrySample> samples = simulateDrive(run.size() * 100);
+    if (samples.empty()) {
+        return;
+    }
+    std::string path = benchLogPath();
+    {
+        TelemetryLogWriter writer;
+        writer.open(path, 1);
+        for (const auto& sample : samples) {
+            writer.append(sample);
+        }
+    }
+
+    TelemetryLogReader reader;
+    if (!reader.open(path)) {
+        return;
+    }
+    TelemetryColumns columns;
+    run.measure(samples.size(), [&] {
+        columns.clear();
+        reader.readRange(samples.front().timestampMs, samples.back().timestampMs + 1, columns);
+        doNotOptimize(columns.speed.back());
+    });
+
+    reader.close();
+    std::remove(path.c_str());
+}
+
+static BenchRegistrar encodeRegistrar("telemetry/encode", &benchTelemetryEncode);
+static BenchRegistrar decodeRegistrar("telemetry/decode", &benchTelemetryDecode);
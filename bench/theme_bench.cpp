@@ -0,0 +1,29 @@
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../output_sink.h"
+#include "../theme.h"
+#include "bench.h"
+
+// Look up and apply themes by name, as switchTheme() does after reading input
+static void benchApplyTheme(BenchRun& run) {
+    std::map<std::string, Theme> themes;
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < run.size(); ++i) {
+        names.push_back("Theme" + std::to_string(i));
+        themes.emplace(names.back(), Theme("White", "Black", 12, "Simple Icons"));
+    }
+    std::shuffle(names.begin(), names.end(), std::mt19937(7));
+
+    run.measure(names.size(), [&] {
+        for (const auto& name : names) {
+            applyTheme(themes, name);
+        }
+        OutputSink::instance().flush();
+    });
+}
+
+static BenchRegistrar applyThemeRegistrar("themes/apply_theme", &benchApplyTheme);
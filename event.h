@@ -0,0 +1,194 @@
+#ifndef EVENT_H
+#define EVENT_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "output_sink.h"
+#include "trace.h"
+
+// Event class to represent a touchscreen input event
+class Event {
+public:
+    enum EventType { TAP, SWIPE };
+    
+    Event(EventType type, int x, int y, time_t timestamp) 
+        : eventType(type), x(x), y(y), timestamp(timestamp) {}
+    
+    EventType eventType;
+    int x, y;
+    time_t timestamp;
+};
+
+// Direction of a swipe: horizontal movement wins, then vertical; "" if it did not move
+inline const char* swipeDirection(const Event& event) {
+    if (event.x > 0) {
+        return "RIGHT";
+    } else if (event.x < 0) {
+        return "LEFT";
+    } else if (event.y > 0) {
+        return "UP";
+    } else if (event.y < 0) {
+        return "DOWN";
+    }
+    return "";
+}
+
+// Function to display the event details
+inline void handleEvent(const Event& event) {
+    HMI_TRACE_SCOPE("handleEvent");
+    // Convert timestamp to readable format
+    char buffer[80];
+    struct tm* timeinfo;
+    timeinfo = localtime(&event.timestamp);
+    strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", timeinfo);
+    
+    // Handle the event
+    if (event.eventType == Event::TAP) {
+        console() << "[" << buffer << "] TAP at position (" << event.x << ", " << event.y << ")\n";
+    }
+    else if (event.eventType == Event::SWIPE) {
+        console() << "[" << buffer << "] SWIPE in direction: " << swipeDirection(event) << "\n";
+    }
+}
+
+// What BoundedEventQueue does with an event that arrives while it is full
+enum class OverloadPolicy {
+    DropOldest,  // discard the longest waiting event to make room
+    DropNewest,  // discard the arriving event
+    Coalesce     // merge it into the last queued event if it repeats it, else drop oldest
+};
+
+struct EventQueueStats {
+    std::uint64_t pushed = 0;
+    std::uint64_t dropped = 0;     // lost to a full queue
+    std::uint64_t coalesced = 0;   // merged into the event queued before them
+    std::size_t highWater = 0;     // most events queued at once
+};
+
+// BoundedEventQueue holds at most `capacity` events in a ring allocated up
+// front, so an input storm cannot grow memory or the wait behind the queue
+// without limit. Policies only apply once the ring is full: until then every
+// event is queued as it arrived, so a double tap stays two taps. When full,
+// Coalesce merges a SWIPE in the same direction as the last queued SWIPE by
+// adding its movement, and a TAP within tapRadius pixels of the last queued
+// TAP by replacing it; the merged event keeps its place in line and its
+// enqueue time.
+class BoundedEventQueue {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit BoundedEventQueue(std::size_t capacity, OverloadPolicy policy = OverloadPolicy::DropOldest,
+                               int tapRadius = 8)
+        : slots(capacity > 0 ? capacity : 1, {Event(Event::TAP, 0, 0, 0), Clock::time_point()}),
+          policy(policy), tapRadius(tapRadius) {}
+
+    // Returns false if the event was dropped
+    bool push(const Event& event) {
+        ++queueStats.pushed;
+        if (policy == OverloadPolicy::Coalesce && count == slots.size() &&
+            coalesce(slots[(head + count - 1) % slots.size()].event, event)) {
+            ++queueStats.coalesced;
+            return true;
+        }
+        if (count == slots.size()) {
+            ++queueStats.dropped;
+            HMI_TRACE_COUNTER("eventQueue dropped", queueStats.dropped);
+            if (policy == OverloadPolicy::DropNewest) {
+                return false;
+            }
+            pop();
+        }
+        slots[(head + count) % slots.size()] = {event, Clock::now()};
+        ++count;
+        if (count > queueStats.highWater) {
+            queueStats.highWater = count;
+        }
+        return true;
+    }
+
+    bool empty() const { return count == 0; }
+    std::size_t size() const { return count; }
+    std::size_t capacity() const { return slots.size(); }
+
+    const Event& front() const { return slots[head].event; }
+
+    // When the front event (or the first event merged into it) was queued
+    Clock::time_point frontEnqueuedAt() const { return slots[head].enqueuedAt; }
+
+    void pop() {
+        head = (head + 1) % slots.size();
+        --count;
+    }
+
+    // Drop every queued event and zero the counters
+    void reset() {
+        head = 0;
+        count = 0;
+        queueStats = EventQueueStats();
+    }
+
+    const EventQueueStats& stats() const { return queueStats; }
+
+    // Memory held by the ring, which never grows after construction
+    std::size_t memoryBytes() const { return slots.capacity() * sizeof(Slot); }
+
+private:
+    struct Slot {
+        Event event;
+        Clock::time_point enqueuedAt;
+    };
+
+    bool coalesce(Event& last, const Event& next) const {
+        if (last.eventType != next.eventType) {
+            return false;
+        }
+        if (next.eventType == Event::SWIPE) {
+            // Summing keeps the direction, since both moved the same way along the axis that decides it
+            if (std::strcmp(swipeDirection(last), swipeDirection(next)) != 0) {
+                return false;
+            }
+            last.x += next.x;
+            last.y += next.y;
+        } else {
+            if (std::abs(last.x - next.x) > tapRadius || std::abs(last.y - next.y) > tapRadius) {
+                return false;
+            }
+            last.x = next.x;
+            last.y = next.y;
+        }
+        last.timestamp = next.timestamp;
+        return true;
+    }
+
+    std::vector<Slot> slots;
+    std::size_t head = 0;
+    std::size_t count = 0;
+    OverloadPolicy policy;
+    int tapRadius;
+    EventQueueStats queueStats;
+};
+
+// Function to simulate random event generation into any queue with push(Event)
+template <typename EventQueue>
+inline void simulateEvents(EventQueue& eventQueue, int numEvents) {
+    srand(time(0)); // Seed for random number generation
+    
+    for (int i = 0; i < numEvents; ++i) {
+        int x = rand() % 500 - 250; // Random x between -250 and 250
+        int y = rand() % 500 - 250; // Random y between -250 and 250
+        time_t timestamp = time(0); // Current time as timestamp
+        Event::EventType type = (rand() % 2 == 0) ? Event::TAP : Event::SWIPE; // Randomly choose between TAP and SWIPE
+        
+        Event newEvent(type, x, y, timestamp);
+        eventQueue.push(newEvent);
+    }
+}
+
+#endif // EVENT_H
@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+#include <vector>
+
+#include "fleet_simulator.h"
+#include "output_sink.h"
+#include "trace.h"
+#include "work_stealing_pool.h"
+
+// Per-worker totals gathered while the batches are produced
+struct alignas(64) FleetSummary {
+    std::int64_t speedTotal = 0;
+    std::size_t vehicles = 0;
+    std::size_t lowFuel = 0;
+    std::size_t overheating = 0;
+};
+
+int main(int argc, char* argv[]) {
+    // Usage: fleet [--vehicles 1000000] [--seconds 5] [--threads N]
+    std::size_t vehicles = 1000000;
+    int seconds = 5;
+    unsigned threads = WorkStealingPool::defaultThreads();
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--vehicles" && i + 1 < argc) {
+            vehicles = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--seconds" && i + 1 < argc) {
+            seconds = std::atoi(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        }
+    }
+
+    WorkStealingPool pool(threads);
+    FleetSimulator fleet(vehicles, pool);
+    std::vector<FleetSummary> summaries(pool.workerCount());
+
+    console() << "Simulating " << fleet.vehicleCount() << " vehicles on " << pool.workerCount() << " threads\n";
+
+    // Every tick is one sample per vehicle, generated as fast as the pool allows;
+    // once a second report the rate and a fleet-wide summary
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point start = Clock::now();
+    Clock::time_point reportAt = start + std::chrono::seconds(1);
+    std::int64_t simulatedMs = 0;
+    std::uint64_t ticks = 0;
+    std::uint64_t ticksSinceReport = 0;
+
+    while (Clock::now() - start < std::chrono::seconds(seconds)) {
+        simulatedMs += 100;
+        for (auto& summary : summaries) {
+            summary = FleetSummary();
+        }
+        fleet.tick(simulatedMs, [&](const FleetBatch& batch, unsigned worker) {
+            FleetSummary& summary = summaries[worker];
+            for (std::size_t i = 0; i < batch.size(); ++i) {
+                summary.speedTotal += batch.speed[i];
+                summary.lowFuel += batch.fuel[i] < 10;
+                summary.overheating += batch.temperature[i] > 100;
+            }
+            summary.vehicles += batch.size();
+        });
+        ++ticks;
+        ++ticksSinceReport;
+
+        Clock::time_point now = Clock::now();
+        if (now >= reportAt) {
+            double elapsed = std::chrono::duration<double>(now - (reportAt - std::chrono::seconds(1))).count();
+            FleetSummary total;
+            for (const auto& summary : summaries) {
+                total.speedTotal += summary.speedTotal;
+                total.vehicles += summary.vehicles;
+                total.lowFuel += summary.lowFuel;
+                total.overheating += summary.overheating;
+            }
+            console() << std::fixed << std::setprecision(1)
+                      << "Samples/s: " << ticksSinceReport * fleet.vehicleCount() / elapsed / 1e6 << " M"
+                      << " | avg speed " << static_cast<double>(total.speedTotal) / std::max<std::size_t>(total.vehicles, 1)
+                      << " km/h | fuel < 10%: " << total.lowFuel << " | temperature > 100°C: " << total.overheating
+                      << "\n";
+            reportAt = now + std::chrono::seconds(1);
+            ticksSinceReport = 0;
+        }
+    }
+
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    console() << std::fixed << std::setprecision(1) << "Total: " << ticks * fleet.vehicleCount() / elapsed / 1e6
+              << " M samples/s over " << ticks << " ticks, " << pool.steals() << " chunks stolen\n";
+    return 0;
+}
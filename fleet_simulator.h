@@ -0,0 +1,119 @@
+#ifndef FLEET_SIMULATOR_H
+#define FLEET_SIMULATOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "trace.h"
+#include "work_stealing_pool.h"
+#include "xoshiro.h"
+
+// Latest readings of a contiguous group of vehicles, one vector per signal.
+// Batches are owned by the simulator and updated in place every tick, so
+// downstream stages read them by reference instead of copying samples out.
+struct FleetBatch {
+    std::size_t firstVehicle = 0;
+    std::int64_t timestampMs = 0;
+    std::vector<std::int32_t> speed;
+    std::vector<std::int32_t> fuel;
+    std::vector<std::int32_t> temperature;
+
+    std::size_t size() const { return speed.size(); }
+};
+
+// FleetSimulator drives the same signals as VehicleData for a whole fleet.
+// Each tick moves every vehicle one step along a random walk: batches are
+// spread over a work-stealing pool, and every pool worker draws from its own
+// xoshiro stream in bulk, one call per signal per batch.
+class FleetSimulator {
+public:
+    static constexpr std::size_t defaultBatchVehicles = 4096;
+
+    FleetSimulator(std::size_t vehicles, WorkStealingPool& pool, std::size_t batchVehicles = defaultBatchVehicles,
+                   std::uint64_t seed = 2024)
+        : pool(pool), workers(pool.workerCount()) {
+        batchVehicles = std::max<std::size_t>(batchVehicles, 1);
+        Xoshiro256 rng(seed);
+        for (std::size_t first = 0; first < vehicles; first += batchVehicles) {
+            FleetBatch batch;
+            batch.firstVehicle = first;
+            std::size_t count = std::min(batchVehicles, vehicles - first);
+            batch.speed.resize(count);
+            batch.fuel.resize(count);
+            batch.temperature.resize(count);
+            rng.fillRange(batch.speed.data(), count, 0, 200);
+            rng.fillRange(batch.fuel.data(), count, 10, 100);
+            rng.fillRange(batch.temperature.data(), count, 60, 120);
+            batches.push_back(std::move(batch));
+        }
+        for (auto& worker : workers) {
+            rng.jump();
+            worker.rng = rng;
+            worker.steps.resize(batchVehicles);
+        }
+    }
+
+    std::size_t vehicleCount() const {
+        return batches.empty() ? 0 : batches.back().firstVehicle + batches.back().size();
+    }
+
+    const std::vector<FleetBatch>& currentBatches() const { return batches; }
+
+    // Advance every vehicle to timestampMs, then hand each finished batch to
+    // consume(batch, worker) on the worker that produced it, while it is
+    // still in that core's cache
+    template <typename Consumer>
+    void tick(std::int64_t timestampMs, Consumer&& consume) {
+        HMI_TRACE_SCOPE("FleetSimulator::tick");
+        pool.parallelFor(batches.size(), 1, [&](std::size_t begin, std::size_t end, unsigned worker) {
+            for (std::size_t b = begin; b < end; ++b) {
+                advance(batches[b], workers[worker], timestampMs);
+                consume(static_cast<const FleetBatch&>(batches[b]), worker);
+            }
+        });
+    }
+
+    void tick(std::int64_t timestampMs) {
+        tick(timestampMs, [](const FleetBatch&, unsigned) {});
+    }
+
+private:
+    // One per pool worker, padded so workers never write the same cache line
+    struct alignas(64) WorkerState {
+        Xoshiro256 rng;
+        std::vector<std::int32_t> steps;
+    };
+
+    static void advance(FleetBatch& batch, WorkerState& worker, std::int64_t timestampMs) {
+        std::size_t count = batch.size();
+        std::int32_t* steps = worker.steps.data();
+        batch.timestampMs = timestampMs;
+
+        // Speed drifts by up to 3 km/h a tick between 0 and 200
+        worker.rng.fillRange(steps, count, -3, 3);
+        for (std::size_t i = 0; i < count; ++i) {
+            batch.speed[i] = std::clamp(batch.speed[i] + steps[i], 0, 200);
+        }
+
+        // Fuel drops one percent on roughly one tick in 500; empty tanks are refilled
+        worker.rng.fillRange(steps, count, 0, 499);
+        for (std::size_t i = 0; i < count; ++i) {
+            std::int32_t fuel = batch.fuel[i] - (steps[i] == 0);
+            batch.fuel[i] = fuel <= 0 ? 100 : fuel;
+        }
+
+        // Temperature wanders by a degree between 60 and 120°C
+        worker.rng.fillRange(steps, count, -1, 1);
+        for (std::size_t i = 0; i < count; ++i) {
+            batch.temperature[i] = std::clamp(batch.temperature[i] + steps[i], 60, 120);
+        }
+    }
+
+    WorkStealingPool& pool;
+    std::vector<WorkerState> workers;
+    std::vector<FleetBatch> batches;
+};
+
+#endif // FLEET_SIMULATOR_H
@@ -0,0 +1,214 @@
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "trace.h"
+
+// Low priority work is deferred to a later frame when the frame is over budget
+enum class TaskPriority { High, Low };
+
+// Frame-time and jitter statistics, all in milliseconds
+struct FrameStats {
+    std::uint64_t frames = 0;
+    double meanFrameMs = 0;       // time spent doing work per frame
+    double maxFrameMs = 0;
+    double meanJitterMs = 0;      // |actual frame interval - target interval|
+    double maxJitterMs = 0;
+    std::uint64_t overBudgetFrames = 0;
+    std::uint64_t deferredTasks = 0;
+    std::uint64_t skippedTasks = 0;
+};
+
+// FrameScheduler runs an update phase at a fixed timestep and a render phase
+// once per frame at the target rate, then spreads periodic tasks over the
+// frames that follow, keeping each frame inside its time budget.
+class FrameScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // budgetFraction is the share of the frame period work may use before
+    // low priority tasks start being deferred
+    explicit FrameScheduler(double targetHz, double budgetFraction = 0.75)
+        : period(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / targetHz))),
+          budget(std::chrono::duration_cast<Clock::duration>(period * budgetFraction)) {}
+
+    // Fixed-step update, called with the step length in seconds
+    void onUpdate(std::function<void(double)> update) { updatePhase = std::move(update); }
+
+    // Render phase, called once per frame after the updates
+    void onRender(std::function<void()> render) { renderPhase = std::move(render); }
+
+    // Run work every everyFrames frames. Tasks sharing a period are staggered
+    // so they do not all land on the same frame. A low priority task that
+    // cannot fit is retried on the next frames and skipped after maxDeferFrames.
+    void addTask(const std::string& name, std::function<void()> work, int everyFrames,
+                 TaskPriority priority = TaskPriority::Low, int maxDeferFrames = 3) {
+        everyFrames = std::max(everyFrames, 1);
+        int samePeriod = 0;
+        for (const auto& task : tasks) {
+            if (task.everyFrames == everyFrames) {
+                ++samePeriod;
+            }
+        }
+        tasks.push_back({name, std::move(work), everyFrames, samePeriod % everyFrames, priority, maxDeferFrames, 0, false});
+    }
+
+    // Run a single frame: updates, render, due tasks, then sleep until the next frame
+    void runFrame() {
+        Clock::time_point frameStart = Clock::now();
+        recordInterval(frameStart);
+        runPhases(frameStart);
+
+        Clock::duration work = Clock::now() - frameStart;
+        recordWork(work);
+        ++frameIndex;
+
+        // Sleep to the next frame boundary; if we fell more than a frame behind,
+        // start counting from now instead of rushing through the missed frames
+        nextFrame = (nextFrame == Clock::time_point() ? frameStart : nextFrame) + period;
+        Clock::time_point now = Clock::now();
+        if (nextFrame < now - period) {
+            nextFrame = now;
+        }
+        std::this_thread::sleep_until(nextFrame);
+    }
+
+    // Run frames until stop() is called, or for frameLimit frames when it is positive
+    void run(std::uint64_t frameLimit = 0) {
+        running = true;
+        for (std::uint64_t i = 0; running && (frameLimit == 0 || i < frameLimit); ++i) {
+            runFrame();
+        }
+    }
+
+    // May be called from a task or phase to end run() after the current frame
+    void stop() { running = false; }
+
+    const FrameStats& stats() const { return frameStats; }
+
+    double targetFrameMs() const {
+        return std::chrono::duration<double, std::milli>(period).count();
+    }
+
+private:
+    struct ScheduledTask {
+        std::string name;
+        std::function<void()> work;
+        int everyFrames;
+        int phase;
+        TaskPriority priority;
+        int maxDeferFrames;
+        int deferredFrames;
+        bool pending;
+    };
+
+    // The working part of a frame, without the sleep that follows it
+    void runPhases(Clock::time_point frameStart) {
+        HMI_TRACE_SCOPE("FrameScheduler::frame");
+
+        // Catch the simulation up in fixed steps; the cap keeps a long stall
+        // from turning into an ever growing backlog of updates
+        if (updatePhase) {
+            accumulated += frameStart - (lastUpdate == Clock::time_point() ? frameStart - period : lastUpdate);
+            lastUpdate = frameStart;
+            double step = std::chrono::duration<double>(period).count();
+            int steps = 0;
+            while (accumulated >= period && steps < maxUpdatesPerFrame) {
+                updatePhase(step);
+                accumulated -= period;
+                ++steps;
+            }
+            if (steps == maxUpdatesPerFrame) {
+                accumulated = Clock::duration::zero();
+            }
+        }
+        if (renderPhase) {
+            renderPhase();
+        }
+        runDueTasks(frameStart);
+        HMI_TRACE_COUNTER("deferred tasks", frameStats.deferredTasks);
+    }
+
+    void runDueTasks(Clock::time_point frameStart) {
+        for (auto& task : tasks) {
+            if (static_cast<int>(frameIndex % task.everyFrames) == task.phase) {
+                if (task.pending) {
+                    // Still waiting from the previous period: that run is lost
+                    ++frameStats.skippedTasks;
+                }
+                task.pending = true;
+                task.deferredFrames = 0;
+            }
+        }
+        for (auto& task : tasks) {
+            if (!task.pending) {
+                continue;
+            }
+            bool overBudget = Clock::now() - frameStart >= budget;
+            if (task.priority == TaskPriority::Low && overBudget) {
+                if (++task.deferredFrames > task.maxDeferFrames) {
+                    task.pending = false;
+                    ++frameStats.skippedTasks;
+                } else {
+                    ++frameStats.deferredTasks;
+                }
+                continue;
+            }
+            task.work();
+            task.pending = false;
+        }
+    }
+
+    void recordInterval(Clock::time_point frameStart) {
+        if (lastFrameStart != Clock::time_point()) {
+            double intervalMs = std::chrono::duration<double, std::milli>(frameStart - lastFrameStart).count();
+            double jitter = std::abs(intervalMs - targetFrameMs());
+            jitterTotalMs += jitter;
+            ++intervals;
+            frameStats.meanJitterMs = jitterTotalMs / intervals;
+            frameStats.maxJitterMs = std::max(frameStats.maxJitterMs, jitter);
+        }
+        lastFrameStart = frameStart;
+    }
+
+    void recordWork(Clock::duration work) {
+        double workMs = std::chrono::duration<double, std::milli>(work).count();
+        workTotalMs += workMs;
+        ++frameStats.frames;
+        frameStats.meanFrameMs = workTotalMs / frameStats.frames;
+        frameStats.maxFrameMs = std::max(frameStats.maxFrameMs, workMs);
+        if (work > budget) {
+            ++frameStats.overBudgetFrames;
+        }
+    }
+
+    static constexpr int maxUpdatesPerFrame = 5;
+
+    Clock::duration period;
+    Clock::duration budget;
+    std::function<void(double)> updatePhase;
+    std::function<void()> renderPhase;
+    std::vector<ScheduledTask> tasks;
+
+    std::uint64_t frameIndex = 0;
+    Clock::duration accumulated = Clock::duration::zero();
+    Clock::time_point lastUpdate;
+    Clock::time_point lastFrameStart;
+    Clock::time_point nextFrame;
+    bool running = false;
+
+    FrameStats frameStats;
+    double workTotalMs = 0;
+    double jitterTotalMs = 0;
+    std::uint64_t intervals = 0;
+};
+
+#endif // FRAME_SCHEDULER_H
@@ -0,0 +1,234 @@
+#ifndef MENU_H
+#define MENU_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "output_sink.h"
+#include "trace.h"
+
+// MenuItem class represents a single menu item
+class MenuItem : public std::enable_shared_from_this<MenuItem> {
+public:
+    std::string name;
+    std::vector<std::shared_ptr<MenuItem>> subMenuItems;
+
+    MenuItem(const std::string &name) : name(name) {}
+
+    void addSubMenu(const std::shared_ptr<MenuItem>& subMenuItem) {
+        subMenuItems.push_back(subMenuItem);
+        subMenuItem->parents.push_back(weak_from_this());
+        touch();
+    }
+
+    // Changes whenever this item or anything below it gains a submenu, so a
+    // rendering of the subtree can tell when it is out of date
+    std::uint64_t revision() const { return subtreeRevision; }
+
+    void displayMenu(int level) const {
+        // Build the whole subtree first so it reaches the console as one record
+        std::string text;
+        renderMenu(level, text);
+        console() << text;
+    }
+
+    void renderMenu(int level, std::string& text) const {
+        // Render the menu item with indentation based on level
+        text.append(2 * level, ' '); // Indentation for submenus
+        text += name;
+        text += '\n';
+
+        // Recursively render submenus
+        for (const auto& subItem : subMenuItems) {
+            subItem->renderMenu(level + 1, text);
+        }
+    }
+
+private:
+    // Bump this subtree's revision and those of every subtree containing it
+    void touch() {
+        ++subtreeRevision;
+        for (const auto& parent : parents) {
+            if (auto item = parent.lock()) {
+                item->touch();
+            }
+        }
+    }
+
+    std::vector<std::weak_ptr<MenuItem>> parents;
+    std::uint64_t subtreeRevision = 0;
+};
+
+// Cache statistics, for tuning the capacity
+struct MenuCacheStats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t invalidations = 0;  // entries found out of date after addSubMenu
+    std::uint64_t evictions = 0;      // entries dropped to stay under the capacity
+    std::size_t entries = 0;
+    std::size_t bytes = 0;
+    std::size_t capacityBytes = 0;
+
+    double hitRate() const {
+        std::uint64_t lookups = hits + misses;
+        return lookups == 0 ? 0.0 : static_cast<double>(hits) / lookups;
+    }
+};
+
+// MenuRenderCache keeps the rendered text of recently shown menus, least
+// recently used first out once the text would exceed the capacity. An entry
+// remembers the subtree revision it was rendered at and is re-rendered once
+// addSubMenu has changed that menu or anything below it; other menus keep
+// their entries.
+class MenuRenderCache {
+public:
+    static constexpr std::size_t defaultCapacityBytes = 64 * 1024;
+
+    // A capacity of 0 disables caching
+    explicit MenuRenderCache(std::size_t capacityBytes = defaultCapacityBytes) {
+        cacheStats.capacityBytes = capacityBytes;
+    }
+
+    // The subtree of menu rendered from level 0; valid until the next call
+    const std::string& render(const std::shared_ptr<MenuItem>& menu) {
+        auto found = index.find(menu.get());
+        if (found != index.end()) {
+            Entry& entry = *found->second;
+            if (entry.menu.lock() == menu && entry.revision == menu->revision()) {
+                ++cacheStats.hits;
+                entries.splice(entries.begin(), entries, found->second);
+                return entry.text;
+            }
+            // Changed since it was rendered, or a new menu at a freed address
+            ++cacheStats.invalidations;
+            erase(found->second);
+        }
+        ++cacheStats.misses;
+
+        std::string text;
+        menu->renderMenu(0, text);
+        std::size_t bytes = entryBytes(text);
+        if (bytes > cacheStats.capacityBytes) {
+            uncached = std::move(text);
+            return uncached;
+        }
+        while (cacheStats.bytes + bytes > cacheStats.capacityBytes) {
+            ++cacheStats.evictions;
+            erase(std::prev(entries.end()));
+        }
+        entries.push_front({menu.get(), menu, menu->revision(), std::move(text)});
+        index[menu.get()] = entries.begin();
+        cacheStats.bytes += bytes;
+        cacheStats.entries = entries.size();
+        HMI_TRACE_COUNTER("menu cache bytes", cacheStats.bytes);
+        return entries.front().text;
+    }
+
+    void clear() {
+        entries.clear();
+        index.clear();
+        cacheStats.entries = 0;
+        cacheStats.bytes = 0;
+    }
+
+    const MenuCacheStats& stats() const { return cacheStats; }
+
+private:
+    struct Entry {
+        const MenuItem* key;
+        std::weak_ptr<MenuItem> menu;
+        std::uint64_t revision;
+        std::string text;
+    };
+
+    // Text plus the entry itself and, roughly, its list links and hash node
+    static std::size_t entryBytes(const std::string& text) {
+        return text.capacity() + sizeof(Entry) + 6 * sizeof(void*);
+    }
+
+    void erase(std::list<Entry>::iterator entry) {
+        cacheStats.bytes -= entryBytes(entry->text);
+        index.erase(entry->key);
+        entries.erase(entry);
+        cacheStats.entries = entries.size();
+    }
+
+    std::list<Entry> entries;  // most recently used first
+    std::unordered_map<const MenuItem*, std::list<Entry>::iterator> index;
+    std::string uncached;
+    MenuCacheStats cacheStats;
+};
+
+// MenuNavigator handles navigation through the menu
+class MenuNavigator {
+private:
+    std::shared_ptr<MenuItem> currentMenu;
+    std::shared_ptr<MenuItem> rootMenu;
+    mutable MenuRenderCache renderCache;
+
+public:
+    MenuNavigator(const std::shared_ptr<MenuItem>& root,
+                  std::size_t cacheBytes = MenuRenderCache::defaultCapacityBytes)
+        : rootMenu(root), currentMenu(root), renderCache(cacheBytes) {}
+
+    void displayCurrentMenu() const {
+        HMI_TRACE_SCOPE("MenuNavigator::displayCurrentMenu");
+        // Same text as currentMenu->displayMenu(0), reused while the menu is unchanged
+        console() << renderCache.render(currentMenu);
+    }
+
+    const MenuCacheStats& cacheStats() const { return renderCache.stats(); }
+
+    void navigateDown(int option) {
+        HMI_TRACE_SCOPE("MenuNavigator::navigateDown");
+        if (option >= 0 && option < currentMenu->subMenuItems.size()) {
+            currentMenu = currentMenu->subMenuItems[option];
+        } else {
+            console() << "Invalid option!\n";
+        }
+    }
+
+    void navigateUp() {
+        HMI_TRACE_SCOPE("MenuNavigator::navigateUp");
+        // Find the parent menu of the current menu
+        if (currentMenu == rootMenu) {
+            console() << "Already at the root menu!\n";
+            return;
+        }
+
+        // Search for the parent menu, starting at the root so its direct
+        // children find their way back to it as well
+        searchParent(rootMenu, currentMenu);
+    }
+
+    void backToRoot() {
+        HMI_TRACE_SCOPE("MenuNavigator::backToRoot");
+        currentMenu = rootMenu;
+    }
+
+    void searchParent(const std::shared_ptr<MenuItem>& parent, const std::shared_ptr<MenuItem>& target) {
+        for (const auto& subItem : parent->subMenuItems) {
+            if (subItem == target) {
+                currentMenu = parent;
+                return;
+            }
+            searchParent(subItem, target);
+        }
+    }
+
+    bool navigateEnter() {
+        // If the current menu has submenus, we can navigate down
+        if (!currentMenu->subMenuItems.empty()) {
+            return true;
+        }
+        return false;
+    }
+};
+
+#endif // MENU_H
@@ -0,0 +1,252 @@
+#ifndef OUTPUT_SINK_H
+#define OUTPUT_SINK_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// OutputSink collects whole console records from any thread and writes them
+// from one writer thread in large batches, so callers never block on the
+// terminal and records from different threads never interleave mid-line.
+// Synchronous mode writes each record straight away, which keeps tests and
+// interactive prompts deterministic.
+class OutputSink {
+public:
+    static OutputSink& instance() {
+        static OutputSink sink;
+        return sink;
+    }
+
+    OutputSink(const OutputSink&) = delete;
+    OutputSink& operator=(const OutputSink&) = delete;
+
+    // Queue one record; never waits for the terminal in asynchronous mode
+    void write(std::string text) {
+        if (synchronous.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(targetMutex);
+            target->write(text.data(), static_cast<std::streamsize>(text.size()));
+            target->flush();
+            return;
+        }
+
+        push(new Record(std::move(text)));
+    }
+
+    // Block until every record queued so far has reached the target. A marker
+    // queued behind them is only reported once the batch holding it has been
+    // written, so records still being linked in by other threads cannot make
+    // the wait end early.
+    void flush() {
+        bool reached = false;
+        Record* marker = new Record();
+        marker->flushReached = &reached;
+        push(marker);
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wake.notify_one();
+        flushed.wait(lock, [&] { return reached; });
+    }
+
+    void setSynchronous(bool enabled) {
+        flush();
+        synchronous.store(enabled, std::memory_order_release);
+    }
+
+    // Send output somewhere other than std::cout, e.g. a std::ostringstream in
+    // tests; returns the previous target so it can be restored
+    std::ostream& setTarget(std::ostream& stream) {
+        flush();
+        std::lock_guard<std::mutex> lock(targetMutex);
+        return *std::exchange(target, &stream);
+    }
+
+    std::uint64_t recordsWritten() const { return recordCount.load(std::memory_order_relaxed); }
+    std::uint64_t batchesWritten() const { return batchCount.load(std::memory_order_relaxed); }
+
+    ~OutputSink() {
+        flush();
+        stopping.store(true, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            wake.notify_one();
+        }
+        writer.join();
+        delete tail;
+    }
+
+private:
+    // Node of a multi-producer single-consumer queue: producers only swap the
+    // head pointer, the writer thread alone walks from the tail
+    struct Record {
+        Record() = default;
+        explicit Record(std::string text) : text(std::move(text)) {}
+
+        std::atomic<Record*> next{nullptr};
+        std::string text;
+        bool* flushReached = nullptr;   // set on flush markers, which carry no text
+    };
+
+    OutputSink() : head(new Record()), tail(head.load()), target(&std::cout) {
+        writer = std::thread([this] { writeLoop(); });
+    }
+
+    void push(Record* record) {
+        Record* previous = head.exchange(record, std::memory_order_acq_rel);
+        previous->next.store(record, std::memory_order_seq_cst);
+
+        if (writerIdle.load(std::memory_order_seq_cst)) {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            wake.notify_one();
+        }
+    }
+
+    // Take everything currently queued, up to batchLimit bytes, into batch;
+    // flush markers taken along the way go to reachedMarkers
+    std::uint64_t takeBatch(std::string& batch) {
+        std::uint64_t taken = 0;
+        while (batch.size() < batchLimit) {
+            Record* next = tail->next.load(std::memory_order_seq_cst);
+            if (next == nullptr) {
+                break;
+            }
+            if (next->flushReached != nullptr) {
+                reachedMarkers.push_back(next->flushReached);
+            } else {
+                batch += next->text;
+                ++taken;
+            }
+            delete tail;
+            tail = next;
+        }
+        return taken;
+    }
+
+    void writeLoop() {
+        std::string batch;
+        batch.reserve(batchLimit);
+        while (true) {
+            batch.clear();
+            std::uint64_t taken = takeBatch(batch);
+            if (taken > 0) {
+                {
+                    std::lock_guard<std::mutex> lock(targetMutex);
+                    target->write(batch.data(), static_cast<std::streamsize>(batch.size()));
+                    target->flush();
+                }
+                recordCount.fetch_add(taken, std::memory_order_relaxed);
+                batchCount.fetch_add(1, std::memory_order_relaxed);
+            }
+            // Markers are reported only after everything queued ahead of them is written
+            bool markers = !reachedMarkers.empty();
+            if (markers) {
+                std::lock_guard<std::mutex> lock(wakeMutex);
+                for (bool* reached : reachedMarkers) {
+                    *reached = true;
+                }
+                reachedMarkers.clear();
+                flushed.notify_all();
+            }
+            if (taken > 0 || markers) {
+                continue;
+            }
+
+            if (stopping.load(std::memory_order_acquire)) {
+                return;
+            }
+
+            // Announce the nap before the last look at the queue so a producer
+            // either sees writerIdle or its record is seen here; the timeout
+            // only covers a producer caught between its two queue steps.
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            writerIdle.store(true, std::memory_order_seq_cst);
+            if (tail->next.load(std::memory_order_seq_cst) == nullptr && !stopping.load(std::memory_order_acquire)) {
+                wake.wait_for(lock, std::chrono::milliseconds(10));
+            }
+            writerIdle.store(false, std::memory_order_seq_cst);
+        }
+    }
+
+    static constexpr std::size_t batchLimit = 64 * 1024;
+
+    std::atomic<Record*> head;
+    Record* tail;
+    std::vector<bool*> reachedMarkers;   // writer thread only
+
+    std::mutex targetMutex;
+    std::ostream* target;
+    std::atomic<bool> synchronous{false};
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::condition_variable flushed;
+    std::atomic<bool> writerIdle{false};
+    std::atomic<bool> stopping{false};
+
+    std::atomic<std::uint64_t> recordCount{0};
+    std::atomic<std::uint64_t> batchCount{0};
+    std::thread writer;
+};
+
+// OutputRecord formats one record with the usual stream syntax and hands it
+// to the sink as a single unit at the end of the statement. Each thread keeps
+// one spare formatting stream, so a record usually costs no stream setup.
+class OutputRecord {
+public:
+    OutputRecord() : stream(std::move(spareStream())) {
+        if (!stream) {
+            stream = std::make_unique<std::ostringstream>();
+        }
+    }
+
+    OutputRecord(const OutputRecord&) = delete;
+    OutputRecord& operator=(const OutputRecord&) = delete;
+
+    template <typename T>
+    OutputRecord& operator<<(const T& value) {
+        *stream << value;
+        return *this;
+    }
+
+    // Manipulators such as std::endl and std::fixed
+    OutputRecord& operator<<(std::ostream& (*manipulator)(std::ostream&)) {
+        *stream << manipulator;
+        return *this;
+    }
+
+    ~OutputRecord() {
+        OutputSink::instance().write(stream->str());
+
+        // Hand the stream back empty and with default formatting
+        stream->str(std::string());
+        stream->clear();
+        stream->flags(std::ios_base::dec | std::ios_base::skipws);
+        stream->precision(6);
+        stream->width(0);
+        stream->fill(' ');
+        spareStream() = std::move(stream);
+    }
+
+private:
+    static std::unique_ptr<std::ostringstream>& spareStream() {
+        thread_local std::unique_ptr<std::ostringstream> spare;
+        return spare;
+    }
+
+    std::unique_ptr<std::ostringstream> stream;
+};
+
+// Start a console record: console() << "Speed: " << speed << "\n";
+inline OutputRecord console() {
+    return OutputRecord();
+}
+
+#endif // OUTPUT_SINK_H
@@ -2,42 +2,16 @@
 #include <iomanip>
 #include <thread>
 #include <chrono>
-#include <random>
 #include <atomic>
+#include <string>
+#include <cstdlib>
+#include <csignal>
 
-// VehicleData class to store vehicle parameters
-class VehicleData {
-public:
-    // Constructor to initialize the vehicle data
-    VehicleData() : speed(0), fuel(100), temperature(70) {}
-
-    // Random number generator to simulate real-time data
-    void updateData() {
-        // Speed between 0 and 200 km/h
-        speed = randGen(0, 200);
-        // Fuel level between 0 and 100%
-        fuel = randGen(0, 100);
-        // Temperature between 60 and 120°C
-        temperature = randGen(60, 120);
-    }
-
-    // Getter methods for vehicle data
-    int getSpeed() const { return speed; }
-    int getFuel() const { return fuel; }
-    int getTemperature() const { return temperature; }
-
-private:
-    // Random number generator for data simulation
-    int randGen(int min, int max) {
-        std::uniform_int_distribution<int> dist(min, max);
-        return dist(rng);
-    }
-
-    int speed;
-    int fuel;
-    int temperature;
-    std::default_random_engine rng{std::random_device{}()};  // Random engine
-};
+#include "frame_scheduler.h"
+#include "output_sink.h"
+#include "telemetry_log.h"
+#include "trace.h"
+#include "vehicle_data.h"
 
 // Display class to show the vehicle data on console
 class Display {
@@ -46,58 +20,171 @@ public:
 
     // Method to display the data
     void showData() {
+        HMI_TRACE_SCOPE("Display::showData");
+        // The whole screen is one record, so a redraw is never split by other output
+        OutputRecord screen;
+
         // Clear screen for better visualization in the console
-        std::cout << "\033[2J\033[1;1H";  // ANSI escape code for clearing the console
+        screen << "\033[2J\033[1;1H";  // ANSI escape code for clearing the console
 
         // Display speed, fuel, and temperature
-        std::cout << "Speed: " << vehicleData.getSpeed() << " km/h\n";
-        std::cout << "Fuel: " << vehicleData.getFuel() << "%\n";
-        std::cout << "Temperature: " << vehicleData.getTemperature() << "°C\n";
+        screen << "Speed: " << vehicleData.getSpeed() << " km/h\n";
+        screen << "Fuel: " << vehicleData.getFuel() << "%\n";
+        screen << "Temperature: " << vehicleData.getTemperature() << "°C\n";
 
         // Display warnings
         if (vehicleData.getFuel() < 10) {
-            std::cout << "Warning: Fuel level is below 10%!\n";
+            screen << "Warning: Fuel level is below 10%!\n";
         }
         if (vehicleData.getTemperature() > 100) {
-            std::cout << "Warning: Engine temperature exceeds 100°C!\n";
+            screen << "Warning: Engine temperature exceeds 100°C!\n";
         }
 
-        std::cout << "\n";
+        screen << "\n";
+    }
+
+    // Method to display how well the frame scheduler is keeping up
+    void showFrameStats(const FrameStats& stats) {
+        console() << std::fixed << std::setprecision(2)
+                  << "Frames: " << stats.frames
+                  << " | work avg " << stats.meanFrameMs << " ms, max " << stats.maxFrameMs << " ms"
+                  << " | jitter avg " << stats.meanJitterMs << " ms, max " << stats.maxJitterMs << " ms"
+                  << " | deferred " << stats.deferredTasks << ", skipped " << stats.skippedTasks << "\n";
     }
 
 private:
     VehicleData& vehicleData;
 };
 
+// Cleared to make the update and display threads finish their loops
+std::atomic<bool> threadsRunning{true};
+
+// Set by Ctrl-C, so the program stops normally and closes the telemetry log
+volatile std::sig_atomic_t stopRequested = 0;
+
+void requestStop(int) {
+    stopRequested = 1;
+}
+
+// One block per minute of samples, so an interrupted run loses at most that much
+constexpr std::uint32_t logBlockSamples = 60;
+
+// Function to append the current readings to the telemetry log, if one is open
+void logSample(TelemetryLogWriter* log, const VehicleData& vehicleData) {
+    if (log == nullptr) {
+        return;
+    }
+    static const auto start = std::chrono::steady_clock::now();
+    std::int64_t elapsedMs =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    if (!log->append({elapsedMs, vehicleData.getSpeed(), vehicleData.getFuel(), vehicleData.getTemperature()})) {
+        console() << "Warning: telemetry log write failed!\n";
+    }
+}
+
 // Function to update vehicle data every second in a separate thread
-void updateDataThread(VehicleData& vehicleData) {
-    while (true) {
+void updateDataThread(VehicleData& vehicleData, TelemetryLogWriter* log) {
+    HMI_TRACE_THREAD("updateDataThread");
+    while (threadsRunning) {
         vehicleData.updateData();
+        logSample(log, vehicleData);
         std::this_thread::sleep_for(std::chrono::seconds(1));
     }
 }
 
 // Function to display data every second in a separate thread
 void displayDataThread(Display& display) {
-    while (true) {
+    HMI_TRACE_THREAD("displayDataThread");
+    while (threadsRunning) {
         display.showData();
         std::this_thread::sleep_for(std::chrono::seconds(1));
     }
 }
 
-int main() {
+// Function to drive telemetry refresh and display redraw from a 60 Hz frame scheduler
+void runScheduled(VehicleData& vehicleData, Display& display, TelemetryLogWriter* log, int seconds) {
+    HMI_TRACE_THREAD("scheduler");
+    FrameScheduler scheduler(60.0);
+
+    // Refresh the data once a second; the redraw shares the period, so the
+    // scheduler staggers it onto the following frame and may defer it when busy
+    scheduler.addTask("telemetry refresh", [&] {
+        vehicleData.updateData();
+        logSample(log, vehicleData);
+    }, 60, TaskPriority::High);
+    scheduler.addTask("display redraw", [&] {
+        display.showData();
+        display.showFrameStats(scheduler.stats());
+    }, 60, TaskPriority::Low);
+    scheduler.addTask("stop check", [&] {
+        if (stopRequested) {
+            scheduler.stop();
+        }
+    }, 1, TaskPriority::High);
+
+    // Run until interrupted, or for the requested number of seconds
+    scheduler.run(seconds > 0 ? static_cast<std::uint64_t>(seconds) * 60 : 0);
+}
+
+int main(int argc, char* argv[]) {
     // Create a VehicleData object
     VehicleData vehicleData;
     // Create a Display object passing vehicleData
     Display display(vehicleData);
 
-    // Start the update data and display threads
-    std::thread updateThread(updateDataThread, std::ref(vehicleData));
-    std::thread displayThread(displayDataThread, std::ref(display));
+    // Pass --threads to use the original pair of sleeping threads,
+    // --seconds N to stop after N seconds (e.g. to get a complete trace),
+    // and --log FILE to record every sample to a compressed telemetry log
+    bool useThreads = false;
+    int seconds = 0;
+    std::string logPath;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--threads") {
+            useThreads = true;
+        } else if (arg == "--seconds" && i + 1 < argc) {
+            seconds = std::atoi(argv[++i]);
+        } else if (arg == "--log" && i + 1 < argc) {
+            logPath = argv[++i];
+        }
+    }
 
-    // Join the threads to the main thread so the program doesn't exit immediately
-    updateThread.join();
-    displayThread.join();
+    TelemetryLogWriter logWriter;
+    TelemetryLogWriter* log = nullptr;
+    if (!logPath.empty()) {
+        if (!logWriter.open(logPath, 1, logBlockSamples)) {
+            std::cerr << "Cannot write telemetry log " << logPath << "\n";
+            return 1;
+        }
+        log = &logWriter;
+    }
+
+    std::signal(SIGINT, requestStop);
+
+    if (useThreads) {
+        // Start the update data and display threads
+        std::thread updateThread(updateDataThread, std::ref(vehicleData), log);
+        std::thread displayThread(displayDataThread, std::ref(display));
+
+        // Run until interrupted, or for the requested number of seconds
+        auto stopAt = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+        while (!stopRequested && (seconds <= 0 || std::chrono::steady_clock::now() < stopAt)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        threadsRunning = false;
+
+        // Join the threads to the main thread so the program doesn't exit immediately
+        updateThread.join();
+        displayThread.join();
+    } else {
+        runScheduled(vehicleData, display, log, seconds);
+    }
+
+    if (log != nullptr && !logWriter.close()) {
+        OutputSink::instance().flush();
+        std::cerr << "Writing telemetry log " << logPath << " failed\n";
+        return 1;
+    }
 
     return 0;
 }
@@ -0,0 +1,490 @@
+#ifndef TELEMETRY_LOG_H
+#define TELEMETRY_LOG_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Append-only, columnar telemetry log for one vehicle.
+//
+// File layout (little-endian):
+//   file header   magic "HMITLOG1", u32 version, u32 vehicleId, u32 blockSamples
+//   block*        block header followed by one bit-packed column per signal
+//
+// Inside a block, timestamps are stored as delta-of-delta and every signal as
+// the delta to the previous sample. Each column is zigzag encoded and packed
+// at the smallest bit width that fits its largest value, so a steady 10 Hz
+// clock costs zero bits per sample and slowly changing signals a few bits.
+// Version 2 packs each column in interleaved lanes (see packBits).
+
+// One telemetry sample as recorded by VehicleData
+struct TelemetrySample {
+    std::int64_t timestampMs;
+    std::int32_t speed;
+    std::int32_t fuel;
+    std::int32_t temperature;
+};
+
+// Decoded samples, one vector per signal
+struct TelemetryColumns {
+    std::vector<std::int64_t> timestamps;
+    std::vector<std::int32_t> speed;
+    std::vector<std::int32_t> fuel;
+    std::vector<std::int32_t> temperature;
+
+    std::size_t size() const { return timestamps.size(); }
+
+    void clear() {
+        timestamps.clear();
+        speed.clear();
+        fuel.clear();
+        temperature.clear();
+    }
+};
+
+constexpr std::size_t telemetrySignalCount = 3;
+
+// Zigzag maps small negative and positive numbers to small unsigned ones
+inline std::uint64_t zigzagEncode(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+inline std::int64_t zigzagDecode(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+inline unsigned bitWidth(std::uint64_t value) {
+    unsigned width = 0;
+    while (value != 0) {
+        ++width;
+        value >>= 1;
+    }
+    return width;
+}
+
+// Columns are packed in packLanes interleaved lanes: value i goes to lane
+// i % packLanes, and word k of every lane is stored together. Values at the
+// same position in each lane then share one bit offset, so unpacking shifts
+// a run of adjacent words by the same amount, which the compiler vectorizes.
+constexpr std::size_t packLanes = 4;
+
+// Words taken by count values packed at width bits
+inline std::size_t packedWords(std::size_t count, unsigned width) {
+    std::size_t perLane = (count + packLanes - 1) / packLanes;
+    return packLanes * ((perLane * width + 63) / 64);
+}
+
+// Pack values at width bits each onto the end of out
+inline void packBits(const std::vector<std::uint64_t>& values, unsigned width, std::vector<std::uint64_t>& out) {
+    if (width == 0 || values.empty()) {
+        return;
+    }
+    std::size_t base = out.size();
+    out.resize(base + packedWords(values.size(), width), 0);
+    std::uint64_t* words = out.data() + base;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        std::size_t bit = i / packLanes * width;
+        std::uint64_t* lane = words + bit / 64 * packLanes + i % packLanes;
+        unsigned shift = bit % 64;
+        lane[0] |= values[i] << shift;
+        if (shift + width > 64) {
+            lane[packLanes] |= values[i] >> (64 - shift);
+        }
+    }
+}
+
+// Unpack count values of width bits, rounded up to a whole number of lane
+// groups: out needs room for that many, and the caller guarantees packLanes
+// readable words of padding after the column.
+inline void unpackBits(const std::uint64_t* words, std::size_t count, unsigned width, std::uint64_t* out) {
+    std::size_t groups = (count + packLanes - 1) / packLanes;
+    if (width == 0) {
+        std::fill(out, out + groups * packLanes, 0);
+        return;
+    }
+    const std::uint64_t mask = width == 64 ? ~0ULL : (1ULL << width) - 1;
+    for (std::size_t group = 0; group < groups; ++group) {
+        std::size_t bit = group * width;
+        unsigned shift = bit % 64;
+        // Loading the two words of every lane first tells the compiler the
+        // stores below cannot overwrite them
+        std::uint64_t low[packLanes];
+        std::uint64_t high[packLanes];
+        for (std::size_t lane = 0; lane < packLanes; ++lane) {
+            low[lane] = words[bit / 64 * packLanes + lane];
+            high[lane] = words[(bit / 64 + 1) * packLanes + lane];
+        }
+        for (std::size_t lane = 0; lane < packLanes; ++lane) {
+            // (x << 1) << (63 - shift) is x << (64 - shift) without the undefined shift by 64
+            out[group * packLanes + lane] = ((low[lane] >> shift) | ((high[lane] << 1) << (63 - shift))) & mask;
+        }
+    }
+}
+
+// Turn unpacked zigzag values into signed deltas in place
+inline void zigzagDecodeAll(std::uint64_t* values, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        values[i] = static_cast<std::uint64_t>(zigzagDecode(values[i]));
+    }
+}
+
+// Fixed-size part of every block, written before its packed columns
+struct TelemetryBlockHeader {
+    static constexpr std::uint32_t blockMagic = 0x4b4c4254;  // "TBLK"
+
+    std::uint32_t magic;
+    std::uint32_t sampleCount;
+    std::int64_t firstTimestamp;
+    std::int64_t lastTimestamp;
+    std::int64_t firstInterval;                       // second timestamp minus the first
+    std::int32_t firstValues[telemetrySignalCount];
+    std::uint8_t widths[telemetrySignalCount + 1];    // timestamp column first
+    std::uint32_t payloadWords;
+};
+
+// TelemetryLogWriter: buffers at most one block of samples, then encodes and
+// appends it, so memory stays bounded however long the log runs.
+class TelemetryLogWriter {
+public:
+    static constexpr std::uint32_t defaultBlockSamples = 4096;
+
+    TelemetryLogWriter() = default;
+    TelemetryLogWriter(const TelemetryLogWriter&) = delete;
+    TelemetryLogWriter& operator=(const TelemetryLogWriter&) = delete;
+
+    // Start a new log file; returns false if it cannot be created
+    bool open(const std::string& path, std::uint32_t vehicleId, std::uint32_t blockSamples = defaultBlockSamples) {
+        close();
+        file = std::fopen(path.c_str(), "wb");
+        if (file == nullptr) {
+            return false;
+        }
+        samplesPerBlock = std::max<std::uint32_t>(blockSamples, 2);
+        pending.reserve(samplesPerBlock);
+        bytesWritten = 0;
+        samplesWritten = 0;
+        writeFailed = false;
+        std::uint32_t header[3] = {fileVersion, vehicleId, samplesPerBlock};
+        if (std::fwrite(fileMagic, 1, sizeof(fileMagic), file) != sizeof(fileMagic) ||
+            std::fwrite(header, sizeof(header), 1, file) != 1 || std::fflush(file) != 0) {
+            std::fclose(file);
+            file = nullptr;
+            return false;
+        }
+        bytesWritten = sizeof(fileMagic) + sizeof(header);
+        return true;
+    }
+
+    // Samples must arrive in timestamp order. Returns false if a completed
+    // block could not be written; that block is lost, the log stays readable
+    // up to the block before it.
+    bool append(const TelemetrySample& sample) {
+        pending.push_back(sample);
+        if (pending.size() == samplesPerBlock) {
+            return writeBlock();
+        }
+        return true;
+    }
+
+    // Write the partial last block and close the file; false if any write failed
+    bool close() {
+        if (file == nullptr) {
+            return !writeFailed;
+        }
+        writeBlock();
+        if (std::fclose(file) != 0) {
+            writeFailed = true;
+        }
+        file = nullptr;
+        return !writeFailed;
+    }
+
+    // False once any write has failed
+    bool good() const { return !writeFailed; }
+
+    // Bytes and samples that have actually reached the file
+    std::uint64_t bytes() const { return bytesWritten; }
+    std::uint64_t samples() const { return samplesWritten; }
+
+    ~TelemetryLogWriter() {
+        close();
+    }
+
+    static constexpr char fileMagic[8] = {'H', 'M', 'I', 'T', 'L', 'O', 'G', '1'};
+    static constexpr std::uint32_t fileVersion = 2;
+
+private:
+    // Each block is flushed as it is written, so a crash loses at most the
+    // samples still buffered
+    bool writeBlock() {
+        if (pending.empty()) {
+            return true;
+        }
+        std::size_t count = pending.size();
+
+        TelemetryBlockHeader header{};
+        header.magic = TelemetryBlockHeader::blockMagic;
+        header.sampleCount = static_cast<std::uint32_t>(count);
+        header.firstTimestamp = pending.front().timestampMs;
+        header.lastTimestamp = pending.back().timestampMs;
+        header.firstInterval = count > 1 ? pending[1].timestampMs - pending[0].timestampMs : 0;
+        header.firstValues[0] = pending.front().speed;
+        header.firstValues[1] = pending.front().fuel;
+        header.firstValues[2] = pending.front().temperature;
+
+        payload.clear();
+
+        // Timestamps: delta-of-delta from the third sample on
+        column.clear();
+        for (std::size_t i = 2; i < count; ++i) {
+            std::int64_t interval = pending[i].timestampMs - pending[i - 1].timestampMs;
+            std::int64_t previous = pending[i - 1].timestampMs - pending[i - 2].timestampMs;
+            column.push_back(zigzagEncode(interval - previous));
+        }
+        header.widths[0] = static_cast<std::uint8_t>(packColumn());
+
+        // Signals: delta to the previous sample
+        const std::int32_t TelemetrySample::*signals[telemetrySignalCount] = {
+            &TelemetrySample::speed, &TelemetrySample::fuel, &TelemetrySample::temperature};
+        for (std::size_t s = 0; s < telemetrySignalCount; ++s) {
+            column.clear();
+            for (std::size_t i = 1; i < count; ++i) {
+                column.push_back(zigzagEncode(static_cast<std::int64_t>(pending[i].*signals[s]) - pending[i - 1].*signals[s]));
+            }
+            header.widths[s + 1] = static_cast<std::uint8_t>(packColumn());
+        }
+        header.payloadWords = static_cast<std::uint32_t>(payload.size());
+
+        pending.clear();
+        if (std::fwrite(&header, sizeof(header), 1, file) != 1 ||
+            (!payload.empty() && std::fwrite(payload.data(), sizeof(std::uint64_t), payload.size(), file) != payload.size()) ||
+            std::fflush(file) != 0) {
+            writeFailed = true;
+            return false;
+        }
+        bytesWritten += sizeof(header) + payload.size() * sizeof(std::uint64_t);
+        samplesWritten += count;
+        return true;
+    }
+
+    unsigned packColumn() {
+        std::uint64_t largest = 0;
+        for (std::uint64_t value : column) {
+            largest |= value;
+        }
+        unsigned width = bitWidth(largest);
+        packBits(column, width, payload);
+        return width;
+    }
+
+    std::FILE* file = nullptr;
+    std::uint32_t samplesPerBlock = defaultBlockSamples;
+    std::vector<TelemetrySample> pending;
+    std::vector<std::uint64_t> column;
+    std::vector<std::uint64_t> payload;
+    std::uint64_t bytesWritten = 0;
+    std::uint64_t samplesWritten = 0;
+    bool writeFailed = false;
+};
+
+// TelemetryLogReader: maps a log file read-only, indexes its blocks by time
+// and decodes only the blocks that overlap a requested range.
+class TelemetryLogReader {
+public:
+    TelemetryLogReader() = default;
+    TelemetryLogReader(const TelemetryLogReader&) = delete;
+    TelemetryLogReader& operator=(const TelemetryLogReader&) = delete;
+
+    // Map and index a log; returns false if it is missing or its file header
+    // is malformed. A torn or corrupt block ends the log at the block before it.
+    bool open(const std::string& path) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(fileHeaderBytes)) {
+            ::close(fd);
+            return false;
+        }
+        mappedBytes = static_cast<std::size_t>(info.st_size);
+        void* mapping = ::mmap(nullptr, mappedBytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED) {
+            mappedBytes = 0;
+            return false;
+        }
+        data = static_cast<const unsigned char*>(mapping);
+
+        if (std::memcmp(data, TelemetryLogWriter::fileMagic, sizeof(TelemetryLogWriter::fileMagic)) != 0 ||
+            !buildIndex()) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+        if (data != nullptr) {
+            ::munmap(const_cast<unsigned char*>(data), mappedBytes);
+        }
+        data = nullptr;
+        mappedBytes = 0;
+        blocks.clear();
+    }
+
+    ~TelemetryLogReader() {
+        close();
+    }
+
+    std::uint32_t vehicleId() const { return vehicle; }
+    std::size_t blockCount() const { return blocks.size(); }
+
+    std::uint64_t sampleCount() const {
+        std::uint64_t total = 0;
+        for (const auto& block : blocks) {
+            total += block.header.sampleCount;
+        }
+        return total;
+    }
+
+    // Append every sample with from <= timestamp < to to out
+    void readRange(std::int64_t from, std::int64_t to, TelemetryColumns& out) {
+        // First block that can still contain timestamps >= from
+        auto block = std::lower_bound(blocks.begin(), blocks.end(), from, [](const BlockRef& ref, std::int64_t time) {
+            return ref.header.lastTimestamp < time;
+        });
+        for (; block != blocks.end() && block->header.firstTimestamp < to; ++block) {
+            decodeBlock(*block);
+            auto begin = std::lower_bound(scratch.timestamps.begin(), scratch.timestamps.end(), from);
+            auto end = std::lower_bound(begin, scratch.timestamps.end(), to);
+            std::size_t first = static_cast<std::size_t>(begin - scratch.timestamps.begin());
+            std::size_t last = static_cast<std::size_t>(end - scratch.timestamps.begin());
+            out.timestamps.insert(out.timestamps.end(), begin, end);
+            out.speed.insert(out.speed.end(), scratch.speed.begin() + first, scratch.speed.begin() + last);
+            out.fuel.insert(out.fuel.end(), scratch.fuel.begin() + first, scratch.fuel.begin() + last);
+            out.temperature.insert(out.temperature.end(), scratch.temperature.begin() + first,
+                                   scratch.temperature.begin() + last);
+        }
+    }
+
+private:
+    static constexpr std::size_t fileHeaderBytes = sizeof(TelemetryLogWriter::fileMagic) + 3 * sizeof(std::uint32_t);
+
+    struct BlockRef {
+        TelemetryBlockHeader header;
+        const unsigned char* payload;
+    };
+
+    bool buildIndex() {
+        std::uint32_t fields[3];
+        std::memcpy(fields, data + sizeof(TelemetryLogWriter::fileMagic), sizeof(fields));
+        if (fields[0] != TelemetryLogWriter::fileVersion) {
+            return false;
+        }
+        vehicle = fields[1];
+
+        std::size_t offset = fileHeaderBytes;
+        while (offset + sizeof(TelemetryBlockHeader) <= mappedBytes) {
+            BlockRef ref;
+            std::memcpy(&ref.header, data + offset, sizeof(TelemetryBlockHeader));
+            std::size_t payloadBytes = static_cast<std::size_t>(ref.header.payloadWords) * sizeof(std::uint64_t);
+            if (ref.header.magic != TelemetryBlockHeader::blockMagic ||
+                offset + sizeof(TelemetryBlockHeader) + payloadBytes > mappedBytes || !validHeader(ref.header)) {
+                // A torn final block from an interrupted writer, or a corrupt
+                // one, ends the log; decoding it could read out of bounds
+                break;
+            }
+            ref.payload = data + offset + sizeof(TelemetryBlockHeader);
+            blocks.push_back(ref);
+            offset += sizeof(TelemetryBlockHeader) + payloadBytes;
+        }
+        return true;
+    }
+
+    // The columns must fit the payload exactly at the widths the header claims
+    static bool validHeader(const TelemetryBlockHeader& header) {
+        if (header.sampleCount == 0) {
+            return false;
+        }
+        std::uint64_t count = header.sampleCount;
+        std::uint64_t words = 0;
+        for (std::size_t column = 0; column <= telemetrySignalCount; ++column) {
+            if (header.widths[column] > 64) {
+                return false;
+            }
+            // The timestamp column starts at the third sample, the signals at the second
+            std::uint64_t values = column == 0 ? (count > 2 ? count - 2 : 0) : count - 1;
+            words += packedWords(values, header.widths[column]);
+        }
+        return words == header.payloadWords;
+    }
+
+    // Unpacking and zigzag decoding run over whole columns and vectorize; only
+    // the running sums that rebuild the values are left as scalar loops.
+    void decodeBlock(const BlockRef& block) {
+        const TelemetryBlockHeader& header = block.header;
+        std::size_t count = header.sampleCount;
+
+        // Copy the payload into aligned words, plus padding for unpackBits
+        words.assign(header.payloadWords + packLanes, 0);
+        std::memcpy(words.data(), block.payload, header.payloadWords * sizeof(std::uint64_t));
+        raw.resize(count + packLanes);
+        const std::uint64_t* column = words.data();
+
+        scratch.timestamps.resize(count);
+        scratch.timestamps[0] = header.firstTimestamp;
+        if (count > 1) {
+            scratch.timestamps[1] = wrappingAdd(header.firstTimestamp, header.firstInterval);
+        }
+        if (count > 2) {
+            unpackBits(column, count - 2, header.widths[0], raw.data());
+            zigzagDecodeAll(raw.data(), count - 2);
+            column += packedWords(count - 2, header.widths[0]);
+            std::int64_t interval = header.firstInterval;
+            for (std::size_t i = 2; i < count; ++i) {
+                interval = wrappingAdd(interval, static_cast<std::int64_t>(raw[i - 2]));
+                scratch.timestamps[i] = wrappingAdd(scratch.timestamps[i - 1], interval);
+            }
+        }
+
+        std::vector<std::int32_t>* signals[telemetrySignalCount] = {&scratch.speed, &scratch.fuel, &scratch.temperature};
+        for (std::size_t s = 0; s < telemetrySignalCount; ++s) {
+            std::vector<std::int32_t>& values = *signals[s];
+            values.resize(count);
+            values[0] = header.firstValues[s];
+            unpackBits(column, count - 1, header.widths[s + 1], raw.data());
+            zigzagDecodeAll(raw.data(), count - 1);
+            column += packedWords(count - 1, header.widths[s + 1]);
+            for (std::size_t i = 1; i < count; ++i) {
+                values[i] = static_cast<std::int32_t>(wrappingAdd(values[i - 1], static_cast<std::int64_t>(raw[i - 1])));
+            }
+        }
+    }
+
+    // Sums wrap instead of overflowing, so a corrupt block decodes to wrong
+    // values rather than undefined behaviour
+    static std::int64_t wrappingAdd(std::int64_t a, std::int64_t b) {
+        return static_cast<std::int64_t>(static_cast<std::uint64_t>(a) + static_cast<std::uint64_t>(b));
+    }
+
+    const unsigned char* data = nullptr;
+    std::size_t mappedBytes = 0;
+    std::uint32_t vehicle = 0;
+    std::vector<BlockRef> blocks;
+    std::vector<std::uint64_t> words;
+    std::vector<std::uint64_t> raw;
+    TelemetryColumns scratch;
+};
+
+#endif // TELEMETRY_LOG_H
@@ -0,0 +1,71 @@
+#ifndef THEME_H
+#define THEME_H
+
+#include <iostream>
+#include <map>
+#include <string>
+
+#include "output_sink.h"
+
+// Theme class to represent a display theme/skin
+class Theme {
+public:
+    // Constructor to initialize the theme's attributes
+    Theme(std::string backgroundColor, std::string fontColor, int fontSize, std::string iconStyle)
+        : backgroundColor(backgroundColor), fontColor(fontColor), fontSize(fontSize), iconStyle(iconStyle) {}
+
+    // Method to display the theme details (preview)
+    void display() const {
+        console() << "Background Color: " << backgroundColor << "\n"
+                  << "Font Color: " << fontColor << "\n"
+                  << "Font Size: " << fontSize << "\n"
+                  << "Icon Style: " << iconStyle << "\n";
+    }
+
+    // Method to apply the theme (in this case, just display its details)
+    void apply() const {
+        console() << "\nApplying Theme...\n";
+        display();  // Show the details of the selected theme
+    }
+
+private:
+    std::string backgroundColor;
+    std::string fontColor;
+    int fontSize;
+    std::string iconStyle;
+};
+
+// Function to display available themes to the user
+inline void showAvailableThemes(const std::map<std::string, Theme>& themes) {
+    OutputRecord list;
+    list << "\nAvailable Themes:\n";
+    for (const auto& theme : themes) {
+        list << "- " << theme.first << "\n";  // Display theme names
+    }
+}
+
+// Function to apply a theme by name; returns false if there is no such theme
+inline bool applyTheme(const std::map<std::string, Theme>& themes, const std::string& selectedTheme) {
+    // Check if the selected theme exists in the map
+    auto it = themes.find(selectedTheme);
+    if (it != themes.end()) {
+        console() << "\nYou selected the " << selectedTheme << " Theme!\n";
+        it->second.apply();  // Apply and display the selected theme
+        return true;
+    }
+    console() << "\nInvalid theme name. Please try again.\n";
+    return false;
+}
+
+// Function to switch themes based on user input
+inline void switchTheme(std::map<std::string, Theme>& themes) {
+    std::string selectedTheme;
+    console() << "Enter the theme name to apply: ";
+    // The prompt has to be on screen before we wait for input
+    OutputSink::instance().flush();
+    std::cin >> selectedTheme;
+
+    applyTheme(themes, selectedTheme);
+}
+
+#endif // THEME_H
@@ -0,0 +1,190 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+// Low-overhead tracing: scoped timers, counters and thread names recorded into
+// per-thread buffers and exported as Chrome trace JSON, which chrome://tracing
+// and ui.perfetto.dev both open.
+//
+//   HMI_TRACE_SCOPE("Display::showData");      // time the enclosing scope
+//   HMI_TRACE_COUNTER("eventQueue", size);     // sample a value
+//   HMI_TRACE_THREAD("update");                // name the calling thread
+//
+// Tracing is compiled in only when HMI_TRACING is defined (cmake -DHMI_TRACING=ON);
+// otherwise every macro expands to nothing. When enabled, the trace is written
+// at exit to $HMI_TRACE_FILE, or hmi_trace.json if that is not set.
+
+#ifdef HMI_TRACING
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct TraceEvent {
+    const char* name;       // must outlive the trace, e.g. a string literal
+    std::uint64_t startNs;
+    std::uint64_t durationNs;
+    std::int64_t value;
+    char phase;             // 'X' complete scope, 'C' counter sample
+};
+
+// Events of one thread. Only the owning thread appends; the exporter reads up
+// to the published count, so recording never takes a lock. A full buffer
+// drops further events and counts them rather than growing under the reader.
+class TraceBuffer {
+public:
+    static constexpr std::size_t capacity = 1 << 16;
+
+    explicit TraceBuffer(std::uint32_t threadId) : threadId(threadId), events(new TraceEvent[capacity]) {}
+
+    void record(const TraceEvent& event) {
+        std::size_t used = count.load(std::memory_order_relaxed);
+        if (used == capacity) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        events[used] = event;
+        count.store(used + 1, std::memory_order_release);
+    }
+
+    const std::uint32_t threadId;
+    std::atomic<const char*> threadName{nullptr};
+    std::atomic<std::size_t> count{0};
+    std::atomic<std::uint64_t> dropped{0};
+    std::unique_ptr<TraceEvent[]> events;
+};
+
+class Tracer {
+public:
+    static Tracer& instance() {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    // Nanoseconds since the tracer started
+    std::uint64_t now() const {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+    }
+
+    TraceBuffer& threadBuffer() {
+        thread_local TraceBuffer* buffer = registerThread();
+        return *buffer;
+    }
+
+    static void counter(const char* name, std::int64_t value) {
+        Tracer& tracer = instance();
+        tracer.threadBuffer().record({name, tracer.now(), 0, value, 'C'});
+    }
+
+    static void nameThread(const char* name) {
+        instance().threadBuffer().threadName.store(name, std::memory_order_release);
+    }
+
+    // Write everything recorded so far; safe while other threads keep tracing
+    bool writeChromeTrace(const std::string& path) {
+        std::ofstream out(path);
+        if (!out) {
+            return false;
+        }
+        out << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+        bool first = true;
+        auto separator = [&] {
+            out << (first ? "\n" : ",\n");
+            first = false;
+        };
+
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (const auto& buffer : buffers) {
+            const char* threadName = buffer->threadName.load(std::memory_order_acquire);
+            if (threadName != nullptr) {
+                separator();
+                out << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << buffer->threadId
+                    << ", \"args\": {\"name\": \"" << threadName << "\"}}";
+            }
+
+            std::size_t count = buffer->count.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < count; ++i) {
+                const TraceEvent& event = buffer->events[i];
+                separator();
+                out << "{\"name\": \"" << event.name << "\", \"ph\": \"" << event.phase
+                    << "\", \"pid\": 1, \"tid\": " << buffer->threadId << ", \"ts\": " << event.startNs / 1000.0;
+                if (event.phase == 'X') {
+                    out << ", \"dur\": " << event.durationNs / 1000.0 << "}";
+                } else {
+                    out << ", \"args\": {\"value\": " << event.value << "}}";
+                }
+            }
+
+            std::uint64_t dropped = buffer->dropped.load(std::memory_order_relaxed);
+            if (dropped > 0) {
+                separator();
+                out << "{\"name\": \"dropped events\", \"ph\": \"C\", \"pid\": 1, \"tid\": " << buffer->threadId
+                    << ", \"ts\": " << now() / 1000.0 << ", \"args\": {\"value\": " << dropped << "}}";
+            }
+        }
+        out << "\n]}\n";
+        return static_cast<bool>(out);
+    }
+
+    ~Tracer() {
+        const char* path = std::getenv("HMI_TRACE_FILE");
+        writeChromeTrace(path != nullptr ? path : "hmi_trace.json");
+    }
+
+private:
+    Tracer() : epoch(std::chrono::steady_clock::now()) {}
+
+    // Only taken once per thread, the first time it records anything
+    TraceBuffer* registerThread() {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        buffers.push_back(std::make_unique<TraceBuffer>(static_cast<std::uint32_t>(buffers.size() + 1)));
+        return buffers.back().get();
+    }
+
+    std::chrono::steady_clock::time_point epoch;
+    std::mutex registryMutex;
+    std::vector<std::unique_ptr<TraceBuffer>> buffers;
+};
+
+// Records one complete event covering its own lifetime
+class TraceScope {
+public:
+    explicit TraceScope(const char* name) : name(name), start(Tracer::instance().now()) {}
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+    ~TraceScope() {
+        Tracer& tracer = Tracer::instance();
+        tracer.threadBuffer().record({name, start, tracer.now() - start, 0, 'X'});
+    }
+
+private:
+    const char* name;
+    std::uint64_t start;
+};
+
+#define HMI_TRACE_CONCAT_INNER(a, b) a##b
+#define HMI_TRACE_CONCAT(a, b) HMI_TRACE_CONCAT_INNER(a, b)
+#define HMI_TRACE_SCOPE(name) TraceScope HMI_TRACE_CONCAT(traceScope, __LINE__)(name)
+#define HMI_TRACE_COUNTER(name, value) Tracer::counter(name, static_cast<std::int64_t>(value))
+#define HMI_TRACE_THREAD(name) Tracer::nameThread(name)
+
+#else
+
+// sizeof keeps the value "used" without evaluating it, so variables that only
+// feed a counter do not draw unused warnings when tracing is compiled out
+#define HMI_TRACE_SCOPE(name) ((void)0)
+#define HMI_TRACE_COUNTER(name, value) ((void)sizeof(value))
+#define HMI_TRACE_THREAD(name) ((void)0)
+
+#endif // HMI_TRACING
+
+#endif // TRACE_H
@@ -0,0 +1,43 @@
+#ifndef VEHICLE_DATA_H
+#define VEHICLE_DATA_H
+
+#include <random>
+
+#include "trace.h"
+#include "xoshiro.h"
+
+// VehicleData class to store vehicle parameters
+class VehicleData {
+public:
+    // Constructor to initialize the vehicle data
+    VehicleData() : speed(0), fuel(100), temperature(70) {}
+
+    // Random number generator to simulate real-time data
+    void updateData() {
+        HMI_TRACE_SCOPE("VehicleData::updateData");
+        // Speed between 0 and 200 km/h
+        speed = randGen(0, 200);
+        // Fuel level between 0 and 100%
+        fuel = randGen(0, 100);
+        // Temperature between 60 and 120°C
+        temperature = randGen(60, 120);
+    }
+
+    // Getter methods for vehicle data
+    int getSpeed() const { return speed; }
+    int getFuel() const { return fuel; }
+    int getTemperature() const { return temperature; }
+
+private:
+    // Random number generator for data simulation
+    int randGen(int min, int max) {
+        return rng.range(min, max);
+    }
+
+    int speed;
+    int fuel;
+    int temperature;
+    Xoshiro256 rng{std::random_device{}()};  // Random engine
+};
+
+#endif // VEHICLE_DATA_H
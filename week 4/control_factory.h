@@ -0,0 +1,257 @@
+#ifndef CONTROL_FACTORY_H
+#define CONTROL_FACTORY_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "../output_sink.h"
+
+// Compile-time ids of every concrete control, used to index the factory registry
+enum class ControlType : std::uint8_t { Button, Slider };
+constexpr std::size_t controlTypeCount = 2;
+
+constexpr std::size_t typeIndex(ControlType type) {
+    return static_cast<std::size_t>(type);
+}
+
+// Abstract Product: Control
+class Control {
+public:
+    explicit Control(ControlType type) : controlType(type) {}
+
+    virtual void render() = 0;
+    virtual ~Control() {}
+
+    ControlType type() const { return controlType; }
+
+private:
+    ControlType controlType;
+};
+
+// Concrete Products: Button and Slider
+class ButtonControl : public Control {
+public:
+    static constexpr ControlType typeId = ControlType::Button;
+    static constexpr const char* label = "Rendering Button";
+
+    ButtonControl() : Control(typeId) {}
+
+    void render() override {
+        console() << label << "\n";
+    }
+};
+
+class SliderControl : public Control {
+public:
+    static constexpr ControlType typeId = ControlType::Slider;
+    static constexpr const char* label = "Rendering Slider";
+
+    SliderControl() : Control(typeId) {}
+
+    void render() override {
+        console() << label << "\n";
+    }
+};
+
+// Factory Class: ControlFactory
+class ControlFactory {
+public:
+    static std::unique_ptr<Control> createControl(const std::string& type) {
+        if (type == "Button") {
+            return std::make_unique<ButtonControl>();
+        } else if (type == "Slider") {
+            return std::make_unique<SliderControl>();
+        } else {
+            return nullptr;
+        }
+    }
+};
+
+// Type-erased view of one ControlArena, so a screen can reach every arena by type id
+class ControlArenaBase {
+public:
+    virtual Control* create() = 0;
+    virtual void createBulk(std::size_t count, std::vector<Control*>& out) = 0;
+    virtual void clear() = 0;
+    virtual std::size_t size() const = 0;
+    virtual std::size_t capacity() const = 0;
+    virtual ~ControlArenaBase() {}
+};
+
+// Arena for a single control type. Controls are placement-constructed into
+// fixed-size slabs, so building a screen costs one allocation per slab rather
+// than one per control, and clear() keeps the slabs for the next screen.
+template <typename T>
+class ControlArena : public ControlArenaBase {
+public:
+    static constexpr std::size_t slabSize = 4096;
+
+    ControlArena() = default;
+    ControlArena(const ControlArena&) = delete;
+    ControlArena& operator=(const ControlArena&) = delete;
+
+    ~ControlArena() override {
+        clear();
+    }
+
+    T* emplace() {
+        std::size_t slab = used / slabSize;
+        if (slab == slabs.size()) {
+            addSlab();
+        }
+        T* control = new (&slabs[slab][used % slabSize]) T();
+        ++used;
+        return control;
+    }
+
+    Control* create() override {
+        return emplace();
+    }
+
+    void createBulk(std::size_t count, std::vector<Control*>& out) override {
+        std::size_t needed = (used + count + slabSize - 1) / slabSize;
+        while (slabs.size() < needed) {
+            addSlab();
+        }
+        out.reserve(out.size() + count);
+
+        // Fill whole slab runs at a time instead of re-checking capacity per control
+        while (count > 0) {
+            Slot* slab = slabs[used / slabSize].get();
+            std::size_t offset = used % slabSize;
+            std::size_t run = std::min(count, slabSize - offset);
+            for (std::size_t i = 0; i < run; ++i) {
+                out.push_back(new (&slab[offset + i]) T());
+            }
+            used += run;
+            count -= run;
+        }
+    }
+
+    // Destroy every control but keep the slabs for reuse
+    void clear() override {
+        for (std::size_t i = 0; i < used; ++i) {
+            std::launder(reinterpret_cast<T*>(&slabs[i / slabSize][i % slabSize]))->~T();
+        }
+        used = 0;
+    }
+
+    std::size_t size() const override { return used; }
+    std::size_t capacity() const override { return slabs.size() * slabSize; }
+
+private:
+    struct Slot {
+        alignas(T) unsigned char bytes[sizeof(T)];
+    };
+
+    // Plain new[] leaves the slots uninitialized; make_unique would zero the whole slab
+    void addSlab() {
+        slabs.push_back(std::unique_ptr<Slot[]>(new Slot[slabSize]));
+    }
+
+    std::vector<std::unique_ptr<Slot[]>> slabs;
+    std::size_t used = 0;
+};
+
+template <typename T>
+std::unique_ptr<ControlArenaBase> makeControlArena() {
+    return std::make_unique<ControlArena<T>>();
+}
+
+// Registry: one arena maker per ControlType, indexed by the type id
+using ControlArenaMaker = std::unique_ptr<ControlArenaBase> (*)();
+constexpr std::array<ControlArenaMaker, controlTypeCount> controlRegistry = {
+    &makeControlArena<ButtonControl>,
+    &makeControlArena<SliderControl>,
+};
+static_assert(typeIndex(ButtonControl::typeId) == 0 && typeIndex(SliderControl::typeId) == 1,
+              "controlRegistry must list control types in ControlType order");
+
+// Map the factory's string names onto type ids; returns false for unknown names
+inline bool controlTypeFromName(const std::string& name, ControlType& type) {
+    if (name == "Button") {
+        type = ControlType::Button;
+    } else if (name == "Slider") {
+        type = ControlType::Slider;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// ControlScreen: owns every control built for one screen. Controls live in
+// per-type arenas and are destroyed together when the screen is cleared or
+// goes away; individual controls cannot be destroyed on their own.
+class ControlScreen {
+public:
+    ControlScreen() {
+        for (std::size_t i = 0; i < controlTypeCount; ++i) {
+            arenas[i] = controlRegistry[i]();
+        }
+    }
+
+    ControlScreen(const ControlScreen&) = delete;
+    ControlScreen& operator=(const ControlScreen&) = delete;
+
+    // Type known at compile time: goes straight to the right arena
+    template <typename T>
+    T* create() {
+        T* control = arena<T>().emplace();
+        all.push_back(control);
+        return control;
+    }
+
+    // Type chosen at run time, e.g. from a screen description
+    Control* create(ControlType type) {
+        Control* control = arenas[typeIndex(type)]->create();
+        all.push_back(control);
+        return control;
+    }
+
+    // Create count controls of one type in a single call
+    void createBulk(ControlType type, std::size_t count) {
+        arenas[typeIndex(type)]->createBulk(count, all);
+    }
+
+    template <typename T>
+    void createBulk(std::size_t count) {
+        arena<T>().createBulk(count, all);
+    }
+
+    // Controls in creation order
+    const std::vector<Control*>& controls() const { return all; }
+    std::size_t size() const { return all.size(); }
+
+    std::size_t countOf(ControlType type) const {
+        return arenas[typeIndex(type)]->size();
+    }
+
+    // Destroy the whole screen at once; arena memory is kept for the next build
+    void clear() {
+        all.clear();
+        for (auto& arena : arenas) {
+            arena->clear();
+        }
+    }
+
+    ~ControlScreen() {
+        clear();
+    }
+
+private:
+    template <typename T>
+    ControlArena<T>& arena() {
+        return static_cast<ControlArena<T>&>(*arenas[typeIndex(T::typeId)]);
+    }
+
+    std::array<std::unique_ptr<ControlArenaBase>, controlTypeCount> arenas;
+    std::vector<Control*> all;
+};
+
+#endif // CONTROL_FACTORY_H
@@ -0,0 +1,381 @@
+#ifndef HMI_SYSTEM_H
+#define HMI_SYSTEM_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../output_sink.h"
+#include "../trace.h"
+
+// Display modes known to the HMI, compared as plain integers instead of strings
+enum class Mode : std::uint8_t { Day, Night };
+
+inline const char* modeName(Mode mode) {
+    return mode == Mode::Night ? "Night" : "Day";
+}
+
+// Observer Interface: ModeObserver
+class ModeObserver {
+public:
+    virtual void update(Mode mode) = 0;
+    virtual ~ModeObserver() {}
+};
+
+// Fixed set of worker threads used to fan a notification out over the observer list.
+// run() splits [0, count) into chunks, lets the workers and the caller pick chunks
+// until all are done, and only then returns.
+class NotificationPool {
+public:
+    explicit NotificationPool(std::size_t threadCount) {
+        for (std::size_t i = 0; i < threadCount; ++i) {
+            workers.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ~NotificationPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeWorkers.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    NotificationPool(const NotificationPool&) = delete;
+    NotificationPool& operator=(const NotificationPool&) = delete;
+
+    std::size_t threadCount() const { return workers.size(); }
+
+    void run(std::size_t chunkCount, const std::function<void(std::size_t)>& task) {
+        if (chunkCount == 0) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = &task;
+            jobChunks = chunkCount;
+            nextChunk.store(0, std::memory_order_relaxed);
+            chunksDone = 0;
+            ++generation;
+        }
+        wakeWorkers.notify_all();
+
+        // The calling thread works on the job too instead of just waiting for it
+        runChunks(task, chunkCount);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        jobFinished.wait(lock, [&] { return chunksDone == jobChunks && activeWorkers == 0; });
+        job = nullptr;
+    }
+
+private:
+    void workerLoop() {
+        std::uint64_t seenGeneration = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wakeWorkers.wait(lock, [&] { return stopping || (job != nullptr && generation != seenGeneration); });
+            if (stopping) {
+                return;
+            }
+            seenGeneration = generation;
+            const std::function<void(std::size_t)>& task = *job;
+            std::size_t chunkCount = jobChunks;
+            ++activeWorkers;
+            lock.unlock();
+
+            runChunks(task, chunkCount);
+
+            lock.lock();
+            --activeWorkers;
+            if (chunksDone == jobChunks && activeWorkers == 0) {
+                jobFinished.notify_all();
+            }
+        }
+    }
+
+    void runChunks(const std::function<void(std::size_t)>& task, std::size_t chunkCount) {
+        std::size_t finished = 0;
+        for (std::size_t chunk = nextChunk.fetch_add(1, std::memory_order_relaxed); chunk < chunkCount;
+             chunk = nextChunk.fetch_add(1, std::memory_order_relaxed)) {
+            task(chunk);
+            ++finished;
+        }
+        if (finished > 0) {
+            std::lock_guard<std::mutex> lock(mutex);
+            chunksDone += finished;
+            if (chunksDone == jobChunks) {
+                jobFinished.notify_all();
+            }
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wakeWorkers;
+    std::condition_variable jobFinished;
+    const std::function<void(std::size_t)>* job = nullptr;
+    std::size_t jobChunks = 0;
+    std::size_t chunksDone = 0;
+    std::size_t activeWorkers = 0;
+    std::atomic<std::size_t> nextChunk{0};
+    std::uint64_t generation = 0;
+    bool stopping = false;
+};
+
+// How changeMode() delivers notifications to the observers
+enum class DispatchPolicy {
+    Synchronous,   // notify on the caller's thread before changeMode() returns
+    Asynchronous   // hand the change to a dispatcher thread, coalescing rapid flips
+};
+
+// Singleton: HMI System class
+class HMISystem {
+private:
+    std::atomic<Mode> currentMode;
+    Mode lastDeliveredMode;
+
+    // Observer registration may happen from any thread. The list is left
+    // untouched while a round is in flight: removeObserver() from another
+    // thread waits for the round to end, so the removed observer can no longer
+    // be called once it returns. Calls made from inside update() cannot wait
+    // for their own round, so they are queued and applied when it ends.
+    mutable std::mutex observersMutex;
+    std::condition_variable roundFinished;
+    std::vector<ModeObserver*> observers;
+    std::vector<std::pair<ModeObserver*, bool>> deferredChanges;   // observer, true to add
+    bool roundInFlight = false;
+
+    // Set on every thread while it is calling update(), pool workers included
+    inline static thread_local bool insideUpdate = false;
+
+    // Serializes deliveries so every observer sees mode changes in the same order
+    std::mutex deliveryMutex;
+    std::unique_ptr<NotificationPool> pool;
+    std::size_t parallelThreshold = 1024;
+
+    // Asynchronous dispatcher state
+    DispatchPolicy policy = DispatchPolicy::Synchronous;
+    std::mutex dispatchMutex;
+    std::condition_variable dispatchWake;
+    std::condition_variable dispatchIdle;
+    std::thread dispatcher;
+    bool changePending = false;
+    bool delivering = false;
+    bool stopping = false;
+
+    std::atomic<std::uint64_t> modeChanges{0};
+    std::atomic<std::uint64_t> notificationRounds{0};
+
+    // Private constructor to prevent direct instantiation
+    HMISystem() : currentMode(Mode::Day), lastDeliveredMode(Mode::Day) {}
+
+public:
+    HMISystem(const HMISystem&) = delete;
+    HMISystem& operator=(const HMISystem&) = delete;
+
+    // Method to get the single instance of HMISystem
+    static HMISystem* getInstance() {
+        static HMISystem instance;
+        return &instance;
+    }
+
+    // Get the current mode
+    Mode getCurrentMode() const {
+        return currentMode.load(std::memory_order_acquire);
+    }
+
+    // Add an observer (widget); one added during a round is notified from the next
+    void addObserver(ModeObserver* observer) {
+        std::lock_guard<std::mutex> lock(observersMutex);
+        if (roundInFlight) {
+            deferredChanges.emplace_back(observer, true);
+        } else {
+            observers.push_back(observer);
+        }
+    }
+
+    // Remove an observer; blocks until no notification is still delivering to it.
+    // Called from inside update(), it returns at once and the observer may still
+    // receive the rest of the current round, but none after it.
+    void removeObserver(ModeObserver* observer) {
+        std::unique_lock<std::mutex> lock(observersMutex);
+        if (roundInFlight && insideUpdate) {
+            deferredChanges.emplace_back(observer, false);
+            return;
+        }
+        roundFinished.wait(lock, [&] { return !roundInFlight; });
+        observers.erase(std::remove(observers.begin(), observers.end(), observer), observers.end());
+    }
+
+    std::size_t observerCount() const {
+        std::lock_guard<std::mutex> lock(observersMutex);
+        return observers.size();
+    }
+
+    // Spread each notification over threadCount extra threads once at least
+    // threshold observers are registered; threadCount 0 notifies on one thread.
+    void setNotificationThreads(std::size_t threadCount, std::size_t threshold = 1024) {
+        std::lock_guard<std::mutex> lock(deliveryMutex);
+        pool = threadCount > 0 ? std::make_unique<NotificationPool>(threadCount) : nullptr;
+        parallelThreshold = std::max<std::size_t>(threshold, 1);
+    }
+
+    void setDispatchPolicy(DispatchPolicy newPolicy) {
+        std::unique_lock<std::mutex> lock(dispatchMutex);
+        if (newPolicy == policy) {
+            return;
+        }
+        policy = newPolicy;
+        if (policy == DispatchPolicy::Asynchronous) {
+            stopping = false;
+            dispatcher = std::thread([this] { dispatchLoop(); });
+        } else {
+            stopDispatcher(lock);
+        }
+    }
+
+    // Change mode and notify observers
+    void changeMode(Mode mode) {
+        HMI_TRACE_SCOPE("HMISystem::changeMode");
+        currentMode.store(mode, std::memory_order_release);
+        modeChanges.fetch_add(1, std::memory_order_relaxed);
+        console() << "Mode changed to: " << modeName(mode) << "\n";
+
+        std::unique_lock<std::mutex> lock(dispatchMutex);
+        if (policy == DispatchPolicy::Asynchronous) {
+            changePending = true;
+            lock.unlock();
+            dispatchWake.notify_one();
+        } else {
+            lock.unlock();
+            notifyObservers();
+        }
+    }
+
+    void notifyObservers() {
+        std::lock_guard<std::mutex> lock(deliveryMutex);
+        deliver(getCurrentMode());
+    }
+
+    // Wait until every change made so far has been delivered (asynchronous policy)
+    void flush() {
+        std::unique_lock<std::mutex> lock(dispatchMutex);
+        dispatchIdle.wait(lock, [&] { return !changePending && !delivering; });
+    }
+
+    // Number of changeMode() calls and of notification rounds actually sent;
+    // the difference is how many changes were coalesced away.
+    std::uint64_t modeChangeCount() const { return modeChanges.load(std::memory_order_relaxed); }
+    std::uint64_t notificationCount() const { return notificationRounds.load(std::memory_order_relaxed); }
+
+    ~HMISystem() {
+        std::unique_lock<std::mutex> lock(dispatchMutex);
+        stopDispatcher(lock);
+    }
+
+private:
+    void deliver(Mode mode) {
+        HMI_TRACE_SCOPE("HMISystem::deliver");
+        lastDeliveredMode = mode;
+        std::uint64_t round = notificationRounds.fetch_add(1, std::memory_order_relaxed) + 1;
+        HMI_TRACE_COUNTER("HMISystem notification rounds", round);
+
+        // The list stays fixed for the whole round, so it is read without the lock
+        std::size_t count = 0;
+        {
+            std::lock_guard<std::mutex> lock(observersMutex);
+            roundInFlight = true;
+            count = observers.size();
+        }
+
+        if (!pool || count < parallelThreshold) {
+            notifyRange(0, count, mode);
+        } else {
+            // Give each thread a few chunks so uneven observers still balance out
+            std::size_t chunkCount = (pool->threadCount() + 1) * 4;
+            std::size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+            chunkCount = (count + chunkSize - 1) / chunkSize;
+            pool->run(chunkCount, [&](std::size_t chunk) {
+                std::size_t begin = chunk * chunkSize;
+                notifyRange(begin, std::min(begin + chunkSize, count), mode);
+            });
+        }
+
+        // Apply the registrations queued during the round in the order they came
+        {
+            std::lock_guard<std::mutex> lock(observersMutex);
+            for (const auto& [observer, add] : deferredChanges) {
+                if (add) {
+                    observers.push_back(observer);
+                } else {
+                    observers.erase(std::remove(observers.begin(), observers.end(), observer), observers.end());
+                }
+            }
+            deferredChanges.clear();
+            roundInFlight = false;
+        }
+        roundFinished.notify_all();
+    }
+
+    void notifyRange(std::size_t begin, std::size_t end, Mode mode) {
+        insideUpdate = true;
+        for (std::size_t i = begin; i < end; ++i) {
+            observers[i]->update(mode);
+        }
+        insideUpdate = false;
+    }
+
+    void dispatchLoop() {
+        HMI_TRACE_THREAD("HMISystem dispatcher");
+        std::unique_lock<std::mutex> lock(dispatchMutex);
+        while (true) {
+            dispatchWake.wait(lock, [&] { return stopping || changePending; });
+            if (!changePending) {
+                return;
+            }
+            changePending = false;
+            delivering = true;
+            lock.unlock();
+
+            // Every flip that arrived since the last round collapses into the latest mode;
+            // a burst that ends where it started needs no notification at all.
+            {
+                std::lock_guard<std::mutex> deliveryLock(deliveryMutex);
+                Mode mode = getCurrentMode();
+                if (mode != lastDeliveredMode) {
+                    deliver(mode);
+                }
+            }
+
+            lock.lock();
+            delivering = false;
+            if (!changePending) {
+                dispatchIdle.notify_all();
+            }
+        }
+    }
+
+    void stopDispatcher(std::unique_lock<std::mutex>& lock) {
+        if (!dispatcher.joinable()) {
+            return;
+        }
+        stopping = true;
+        lock.unlock();
+        dispatchWake.notify_one();
+        dispatcher.join();
+        lock.lock();
+    }
+};
+
+#endif // HMI_SYSTEM_H
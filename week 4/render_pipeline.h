@@ -0,0 +1,204 @@
+#ifndef RENDER_PIPELINE_H
+#define RENDER_PIPELINE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "../output_sink.h"
+#include "control_factory.h"
+
+// Ids of the rendering strategies, stored in RenderStrategy so widgets can
+// describe themselves to a frame without a virtual call
+enum class RenderMode : std::uint8_t { Flat2D, Depth3D };
+constexpr std::size_t renderModeCount = 2;
+
+// Strategy Interface: RenderStrategy
+class RenderStrategy {
+public:
+    explicit RenderStrategy(RenderMode mode) : renderMode(mode) {}
+
+    virtual void render() = 0;
+    virtual ~RenderStrategy() {}
+
+    RenderMode mode() const { return renderMode; }
+
+private:
+    RenderMode renderMode;
+};
+
+// Concrete Strategy 1: 2D Rendering
+class Render2D : public RenderStrategy {
+public:
+    static constexpr RenderMode modeId = RenderMode::Flat2D;
+    static constexpr const char* label = "Rendering in 2D";
+
+    Render2D() : RenderStrategy(modeId) {}
+
+    void render() override {
+        console() << label << "\n";
+    }
+};
+
+// Concrete Strategy 2: 3D Rendering
+class Render3D : public RenderStrategy {
+public:
+    static constexpr RenderMode modeId = RenderMode::Depth3D;
+    static constexpr const char* label = "Rendering in 3D";
+
+    Render3D() : RenderStrategy(modeId) {}
+
+    void render() override {
+        console() << label << "\n";
+    }
+};
+
+// Plain description of one widget to draw this frame
+struct RenderCommand {
+    std::uint32_t widgetId;
+    ControlType control;
+    RenderMode mode;
+};
+
+// Compile-time stand-ins for a strategy or control type, so std::visit can
+// pick the batch loop for a (strategy, control) pair once per batch
+template <typename T>
+struct RenderTag {
+    using type = T;
+};
+
+using RenderPassVariant = std::variant<RenderTag<Render2D>, RenderTag<Render3D>>;
+using ControlKindVariant = std::variant<RenderTag<ButtonControl>, RenderTag<SliderControl>>;
+
+constexpr std::array<RenderPassVariant, renderModeCount> renderPasses = {
+    RenderTag<Render2D>{}, RenderTag<Render3D>{}};
+constexpr std::array<ControlKindVariant, controlTypeCount> controlKinds = {
+    RenderTag<ButtonControl>{}, RenderTag<SliderControl>{}};
+static_assert(static_cast<std::size_t>(Render2D::modeId) == 0 && static_cast<std::size_t>(Render3D::modeId) == 1,
+              "renderPasses must list strategies in RenderMode order");
+
+// Tight loop over one batch: every command has the same strategy and control type,
+// so the text each widget produces is known at compile time.
+template <typename Pass, typename ControlT>
+void drawBatch(const RenderCommand* begin, const RenderCommand* end, std::string& out) {
+    const std::string widgetText = std::string(ControlT::label) + '\n' + Pass::label + '\n';
+    out.reserve(out.size() + widgetText.size() * static_cast<std::size_t>(end - begin));
+    for (const RenderCommand* command = begin; command != end; ++command) {
+        out.append(widgetText);
+    }
+}
+
+// FrameCommandBuffer: widgets submit commands during the frame; execute() groups
+// them by strategy, then control type (keeping submission order inside a group),
+// draws each group in one loop and hands the frame to the console as one record,
+// so it stays in order with the rest of the console output.
+class FrameCommandBuffer {
+public:
+    void submit(ControlType control, RenderMode mode) {
+        commands.push_back({static_cast<std::uint32_t>(commands.size()), control, mode});
+    }
+
+    void reserve(std::size_t count) {
+        commands.reserve(count);
+    }
+
+    std::size_t size() const { return commands.size(); }
+
+    void clear() {
+        commands.clear();
+    }
+
+    void execute() {
+        draw();
+        OutputSink::instance().write(frameText);
+    }
+
+    // Write the frame straight to out instead, e.g. a null stream in benchmarks
+    void execute(std::ostream& out) {
+        draw();
+        out.write(frameText.data(), static_cast<std::streamsize>(frameText.size()));
+        out.flush();
+    }
+
+private:
+    static constexpr std::size_t keyCount = renderModeCount * controlTypeCount;
+
+    void draw() {
+        group();
+
+        frameText.clear();
+        std::size_t begin = 0;
+        for (std::size_t key = 0; key < keyCount; ++key) {
+            std::size_t end = begin + bucketSizes[key];
+            if (end == begin) {
+                continue;
+            }
+            const RenderCommand* first = sorted.data() + begin;
+            const RenderCommand* last = sorted.data() + end;
+            std::visit(
+                [&](auto pass, auto control) {
+                    drawBatch<typename decltype(pass)::type, typename decltype(control)::type>(first, last, frameText);
+                },
+                renderPasses[key / controlTypeCount], controlKinds[key % controlTypeCount]);
+            begin = end;
+        }
+    }
+
+    static std::size_t keyOf(const RenderCommand& command) {
+        return static_cast<std::size_t>(command.mode) * controlTypeCount + typeIndex(command.control);
+    }
+
+    // Counting sort: only keyCount distinct keys, so two linear passes do it
+    void group() {
+        bucketSizes.fill(0);
+        for (const RenderCommand& command : commands) {
+            ++bucketSizes[keyOf(command)];
+        }
+        std::array<std::size_t, keyCount> next{};
+        for (std::size_t key = 1; key < keyCount; ++key) {
+            next[key] = next[key - 1] + bucketSizes[key - 1];
+        }
+        sorted.resize(commands.size());
+        for (const RenderCommand& command : commands) {
+            sorted[next[keyOf(command)]++] = command;
+        }
+    }
+
+    std::vector<RenderCommand> commands;
+    std::vector<RenderCommand> sorted;
+    std::array<std::size_t, keyCount> bucketSizes{};
+    std::string frameText;
+};
+
+// Context: WidgetRenderer
+class WidgetRenderer {
+private:
+    std::unique_ptr<RenderStrategy> renderStrategy;
+
+public:
+    WidgetRenderer(std::unique_ptr<RenderStrategy> strategy) : renderStrategy(std::move(strategy)) {}
+
+    void setRenderStrategy(std::unique_ptr<RenderStrategy> strategy) {
+        renderStrategy = std::move(strategy);
+    }
+
+    void renderWidget() {
+        renderStrategy->render();
+    }
+
+    RenderMode mode() const {
+        return renderStrategy->mode();
+    }
+
+    // Queue a control for this frame instead of drawing it immediately
+    void submit(const Control& control, FrameCommandBuffer& frame) const {
+        frame.submit(control.type(), mode());
+    }
+};
+
+#endif // RENDER_PIPELINE_H
@@ -8,6 +8,11 @@ struct Control {
     int id;             // Unique ID
     std::string type;   // "button" or "slider"
     std::string state;  // "visible", "invisible", or "disabled"
+
+    // Define how to compare controls field by field (used by std::equal)
+    bool operator==(const Control& other) const {
+        return id == other.id && type == other.type && state == other.state;
+    }
 };
 
 int main() {
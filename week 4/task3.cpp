@@ -5,15 +5,26 @@
 #include <iterator>
 #include <random>
 
+#include "versioned_store.h"
+
 // Define the Control struct
 struct Control {
     int id;             // Unique ID
     std::string type;   // "button" or "slider"
     std::string state;  // "visible", "invisible", or "disabled"
+
+    // Define how to compare controls, used to diff versions
+    bool operator==(const Control& other) const {
+        return id == other.id && type == other.type && state == other.state;
+    }
 };
 
-// Function to print control list
-void printControls(const std::vector<Control>& controls) {
+// The control list, kept in copy-on-write pages so a backup costs O(1)
+using ControlStore = VersionedStore<Control>;
+
+// Function to print control list (the store or one of its snapshots)
+template <typename Controls>
+void printControls(const Controls& controls) {
     for (const auto& ctrl : controls) {
         std::cout << "ID: " << ctrl.id << ", Type: " << ctrl.type << ", State: " << ctrl.state << "\n";
     }
@@ -21,8 +32,8 @@ void printControls(const std::vector<Control>& controls) {
 }
 
 int main() {
-    // Initialize a vector of controls with sample data
-    std::vector<Control> controls = {
+    // Initialize the control store with sample data
+    ControlStore controls = {
         {1, "button", "visible"},
         {2, "slider", "invisible"},
         {3, "button", "disabled"},
@@ -35,13 +46,14 @@ int main() {
         {10, "slider", "visible"}
     };
 
-    // Step 1: Create a backup of the control list
-    std::vector<Control> backupControls = controls;
+    // Step 1: Create a backup of the control list; the snapshot shares every page with the store
+    ControlStore::Snapshot backupControls = controls.snapshot();
     std::cout << "Backup Controls:\n";
     printControls(backupControls);
 
+    // Steps 2-8 edit the store in place; each page is copied from the backup the first time it is written
     // Step 2: Set all states to "disabled" temporarily
-    std::fill(controls.begin(), controls.end(), Control{0, "", "disabled"});
+    std::fill(controls.editBegin(), controls.editEnd(), Control{0, "", "disabled"});
     std::cout << "All states set to 'disabled':\n";
     printControls(controls);
 
@@ -51,7 +63,7 @@ int main() {
     std::uniform_int_distribution<> distrib(0, 2);
     const std::vector<std::string> states = {"visible", "invisible", "disabled"};
     
-    std::generate(controls.begin(), controls.end(), [&]() {
+    std::generate(controls.editBegin(), controls.editEnd(), [&]() {
         int randomIndex = distrib(gen);
         return Control{0, "", states[randomIndex]};
     });
@@ -59,7 +71,7 @@ int main() {
     printControls(controls);
 
     // Step 4: Use std::transform to change the state of all sliders to "invisible"
-    std::transform(controls.begin(), controls.end(), controls.begin(), [](Control& ctrl) {
+    std::transform(controls.editBegin(), controls.editEnd(), controls.editBegin(), [](Control& ctrl) {
         if (ctrl.type == "slider") {
             ctrl.state = "invisible";
         }
@@ -69,31 +81,38 @@ int main() {
     printControls(controls);
 
     // Step 5: Use std::replace to replace "disabled" with "enabled"
-    std::replace_if(controls.begin(), controls.end(), [](const Control& ctrl) {
+    std::replace_if(controls.editBegin(), controls.editEnd(), [](const Control& ctrl) {
         return ctrl.state == "disabled";
     }, Control{0, "", "enabled"});
     std::cout << "All 'disabled' states replaced with 'enabled':\n";
     printControls(controls);
 
     // Step 6: Use std::remove_if to filter out invisible controls
-    auto newEnd = std::remove_if(controls.begin(), controls.end(), [](const Control& ctrl) {
+    auto newEnd = std::remove_if(controls.editBegin(), controls.editEnd(), [](const Control& ctrl) {
         return ctrl.state == "invisible";
     });
-    controls.erase(newEnd, controls.end());
+    controls.truncate(newEnd.position());
     std::cout << "Invisible controls removed:\n";
     printControls(controls);
 
     // Step 7: Reverse the control list for debugging
-    std::reverse(controls.begin(), controls.end());
+    std::reverse(controls.editBegin(), controls.editEnd());
     std::cout << "Reversed control order:\n";
     printControls(controls);
 
     // Step 8: Partition controls into visible and non-visible
-    auto partitionPoint = std::partition(controls.begin(), controls.end(), [](const Control& ctrl) {
+    auto partitionPoint = std::partition(controls.editBegin(), controls.editEnd(), [](const Control& ctrl) {
         return ctrl.state == "visible";
     });
     std::cout << "Controls partitioned into visible and non-visible:\n";
     printControls(controls);
 
+    // Step 9: Compare the partitioned list with the backup, then roll back
+    std::cout << "Controls changed between the backup and the partitioned list: "
+              << ControlStore::diff(backupControls, controls.snapshot()).size() << "\n";
+    controls.rollback(backupControls);
+    std::cout << "Rolled back to backup:\n";
+    printControls(controls);
+
     return 0;
 }
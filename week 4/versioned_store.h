@@ -0,0 +1,332 @@
+#ifndef VERSIONED_STORE_H
+#define VERSIONED_STORE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// VersionedStore keeps a list of items in fixed-size pages shared between
+// versions. Taking a snapshot only shares the current page table, so it is
+// O(1); the first write after a snapshot copies the table of page pointers
+// and the page being written, leaving every other page shared.
+//
+// Not thread-safe: sharing is detected through shared_ptr use counts, so a
+// store and its snapshots belong to one thread.
+template <typename T, std::size_t PageSize = 64>
+class VersionedStore {
+    using Page = std::vector<T>;                         // full except for the last page
+    using PageTable = std::vector<std::shared_ptr<Page>>;
+
+public:
+    // Iterator over a page table, shared by the store and its snapshots
+    class ConstIterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        ConstIterator(const PageTable* pages, std::size_t index) : pages(pages), index(index) {}
+
+        reference operator*() const { return (*(*pages)[index / PageSize])[index % PageSize]; }
+        pointer operator->() const { return &**this; }
+
+        ConstIterator& operator++() {
+            ++index;
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator previous = *this;
+            ++index;
+            return previous;
+        }
+
+        ConstIterator& operator--() {
+            --index;
+            return *this;
+        }
+
+        ConstIterator operator--(int) {
+            ConstIterator previous = *this;
+            --index;
+            return previous;
+        }
+
+        bool operator==(const ConstIterator& other) const { return index == other.index; }
+        bool operator!=(const ConstIterator& other) const { return index != other.index; }
+
+    private:
+        const PageTable* pages;
+        std::size_t index;
+    };
+
+    // Writable iterator over the store for STL algorithms. Dereferencing goes
+    // through edit(), so only the pages an algorithm touches are copied.
+    class Iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        Iterator(VersionedStore* store, std::size_t index) : store(store), index(index) {}
+
+        reference operator*() const { return store->edit(index); }
+        pointer operator->() const { return &**this; }
+
+        Iterator& operator++() {
+            ++index;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++index;
+            return previous;
+        }
+
+        Iterator& operator--() {
+            --index;
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            Iterator previous = *this;
+            --index;
+            return previous;
+        }
+
+        bool operator==(const Iterator& other) const { return index == other.index; }
+        bool operator!=(const Iterator& other) const { return index != other.index; }
+
+        // Position in the store, e.g. where std::remove_if left the new end
+        std::size_t position() const { return index; }
+
+    private:
+        VersionedStore* store;
+        std::size_t index;
+    };
+
+    // Read-only view of the store at the moment it was taken
+    class Snapshot {
+    public:
+        Snapshot() : table(std::make_shared<PageTable>()) {}
+
+        std::uint64_t version() const { return versionNumber; }
+        std::size_t size() const { return count; }
+        const T& operator[](std::size_t index) const { return (*(*table)[index / PageSize])[index % PageSize]; }
+
+        ConstIterator begin() const { return ConstIterator(table.get(), 0); }
+        ConstIterator end() const { return ConstIterator(table.get(), count); }
+
+    private:
+        friend class VersionedStore;
+
+        Snapshot(std::shared_ptr<const PageTable> table, std::size_t count, std::uint64_t version)
+            : table(std::move(table)), count(count), versionNumber(version) {}
+
+        std::shared_ptr<const PageTable> table;
+        std::size_t count = 0;
+        std::uint64_t versionNumber = 0;
+    };
+
+    VersionedStore() : table(std::make_shared<PageTable>()) {}
+
+    template <typename InputIt>
+    VersionedStore(InputIt first, InputIt last) : VersionedStore() {
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+
+    VersionedStore(std::initializer_list<T> items) : VersionedStore(items.begin(), items.end()) {}
+
+    std::size_t size() const { return count; }
+    const T& operator[](std::size_t index) const { return (*(*table)[index / PageSize])[index % PageSize]; }
+
+    ConstIterator begin() const { return ConstIterator(table.get(), 0); }
+    ConstIterator end() const { return ConstIterator(table.get(), count); }
+
+    // Writable range for STL algorithms; plain iteration should use begin()/end()
+    Iterator editBegin() { return Iterator(this, 0); }
+    Iterator editEnd() { return Iterator(this, count); }
+
+    // Mutable access to one item; copies its page if a snapshot still shares it
+    T& edit(std::size_t index) { return ownPage(index / PageSize)[index % PageSize]; }
+
+    void set(std::size_t index, T value) { edit(index) = std::move(value); }
+
+    void push_back(T value) {
+        if (count % PageSize == 0) {
+            ownTable().push_back(std::make_shared<Page>());
+            table->back()->reserve(PageSize);
+        }
+        ownPage(count / PageSize).push_back(std::move(value));
+        ++count;
+    }
+
+    // Drop the items from newCount on, e.g. after std::remove_if
+    void truncate(std::size_t newCount) {
+        if (newCount >= count) {
+            return;
+        }
+        PageTable& pages = ownTable();
+        pages.resize((newCount + PageSize - 1) / PageSize);
+        if (newCount % PageSize != 0) {
+            Page& last = ownPage(pages.size() - 1);
+            last.erase(last.begin() + newCount % PageSize, last.end());
+        }
+        count = newCount;
+    }
+
+    // Apply fn to every item; every shared page is copied
+    template <typename Fn>
+    void updateAll(Fn fn) {
+        for (std::size_t p = 0; p < table->size(); ++p) {
+            for (T& item : ownPage(p)) {
+                fn(item);
+            }
+        }
+    }
+
+    // Apply fn to the items matching pred, copying only the pages that hold
+    // one; returns the number of items updated
+    template <typename Pred, typename Fn>
+    std::size_t updateIf(Pred pred, Fn fn) {
+        std::size_t updated = 0;
+        for (std::size_t p = 0; p < table->size(); ++p) {
+            for (std::size_t i = 0; i < (*table)[p]->size(); ++i) {
+                if (pred((*(*table)[p])[i])) {
+                    fn(ownPage(p)[i]);
+                    ++updated;
+                }
+            }
+        }
+        return updated;
+    }
+
+    // Remove the items matching pred, keeping their order. Pages before the
+    // first removed item stay shared; the rest are repacked.
+    template <typename Pred>
+    std::size_t eraseIf(Pred pred) {
+        std::size_t first = 0;
+        while (first < count && !pred((*this)[first])) {
+            ++first;
+        }
+        if (first == count) {
+            return 0;
+        }
+
+        std::size_t firstPage = first / PageSize;
+        PageTable rebuilt(table->begin(), table->begin() + firstPage);
+        std::size_t kept = firstPage * PageSize;
+        for (std::size_t i = kept; i < count; ++i) {
+            const T& item = (*this)[i];
+            if (pred(item)) {
+                continue;
+            }
+            if (kept % PageSize == 0) {
+                rebuilt.push_back(std::make_shared<Page>());
+                rebuilt.back()->reserve(PageSize);
+            }
+            rebuilt.back()->push_back(item);
+            ++kept;
+        }
+
+        std::size_t removed = count - kept;
+        table = std::make_shared<PageTable>(std::move(rebuilt));
+        count = kept;
+        return removed;
+    }
+
+    // O(1): the snapshot shares every page until the store next writes to it
+    Snapshot snapshot() {
+        return Snapshot(table, count, ++versionNumber);
+    }
+
+    // O(1): make the snapshot's contents current again; it stays valid
+    void rollback(const Snapshot& snapshot) {
+        table = std::const_pointer_cast<PageTable>(snapshot.table);
+        count = snapshot.count;
+    }
+
+    // Indices whose items differ between two versions, including indices only
+    // one of them has. Pages the versions still share are skipped unread.
+    static std::vector<std::size_t> diff(const Snapshot& from, const Snapshot& to) {
+        std::vector<std::size_t> changed;
+        std::size_t common = std::min(from.count, to.count);
+        for (std::size_t p = 0; p * PageSize < common; ++p) {
+            if ((*from.table)[p] == (*to.table)[p]) {
+                continue;
+            }
+            std::size_t end = std::min(common, (p + 1) * PageSize);
+            for (std::size_t i = p * PageSize; i < end; ++i) {
+                if (!(from[i] == to[i])) {
+                    changed.push_back(i);
+                }
+            }
+        }
+        for (std::size_t i = common; i < std::max(from.count, to.count); ++i) {
+            changed.push_back(i);
+        }
+        return changed;
+    }
+
+    // Bytes held by a set of snapshots, counting each shared page and page
+    // table once; memory owned by the items themselves is not included
+    static std::size_t footprintBytes(const std::vector<Snapshot>& snapshots) {
+        std::unordered_set<const void*> tables;
+        std::unordered_set<const void*> pages;
+        std::size_t bytes = 0;
+        for (const Snapshot& snapshot : snapshots) {
+            if (!tables.insert(snapshot.table.get()).second) {
+                continue;
+            }
+            bytes += sizeof(PageTable) + snapshot.table->capacity() * sizeof(std::shared_ptr<Page>);
+            for (const auto& page : *snapshot.table) {
+                if (pages.insert(page.get()).second) {
+                    bytes += sizeof(Page) + page->capacity() * sizeof(T);
+                }
+            }
+        }
+        return bytes;
+    }
+
+    std::uint64_t pageCopies() const { return pageCopyCount; }
+
+private:
+    PageTable& ownTable() {
+        if (table.use_count() > 1) {
+            table = std::make_shared<PageTable>(*table);
+        }
+        return *table;
+    }
+
+    Page& ownPage(std::size_t page) {
+        PageTable& pages = ownTable();
+        if (pages[page].use_count() > 1) {
+            auto copy = std::make_shared<Page>();
+            copy->reserve(PageSize);
+            copy->assign(pages[page]->begin(), pages[page]->end());
+            pages[page] = std::move(copy);
+            ++pageCopyCount;
+        }
+        return *pages[page];
+    }
+
+    std::shared_ptr<PageTable> table;
+    std::size_t count = 0;
+    std::uint64_t versionNumber = 0;
+    std::uint64_t pageCopyCount = 0;
+};
+
+#endif // VERSIONED_STORE_H
@@ -0,0 +1,170 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "trace.h"
+
+// WorkStealingPool runs a loop over [0, count) split into chunks. Each worker
+// starts on its own contiguous share of the chunks, taking them from the back
+// of its queue; a worker that runs dry steals from the front of another's, so
+// uneven chunks still keep every core busy. The calling thread works too.
+class WorkStealingPool {
+public:
+    static unsigned defaultThreads() {
+        unsigned hardware = std::thread::hardware_concurrency();
+        return hardware > 1 ? hardware - 1 : 1;
+    }
+
+    explicit WorkStealingPool(unsigned threads = defaultThreads()) : queues(threads + 1) {
+        for (unsigned i = 0; i < threads; ++i) {
+            workers.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    // Workers plus the calling thread; worker indices passed to bodies are below this
+    unsigned workerCount() const { return static_cast<unsigned>(queues.size()); }
+
+    std::uint64_t steals() const { return stealCount.load(std::memory_order_relaxed); }
+
+    // Call body(begin, end, worker) for every chunk of chunkSize indices and
+    // return once all of them have finished
+    template <typename Body>
+    void parallelFor(std::size_t count, std::size_t chunkSize, Body&& body) {
+        if (count == 0) {
+            return;
+        }
+        chunkSize = std::max<std::size_t>(chunkSize, 1);
+        std::size_t chunks = (count + chunkSize - 1) / chunkSize;
+
+        std::lock_guard<std::mutex> call(callMutex);
+        jobContext = const_cast<void*>(static_cast<const void*>(std::addressof(body)));
+        jobInvoke = [](void* context, std::size_t begin, std::size_t end, unsigned worker) {
+            (*static_cast<std::remove_reference_t<Body>*>(context))(begin, end, worker);
+        };
+        remaining.store(chunks, std::memory_order_relaxed);
+
+        // Deal contiguous runs of chunks so each worker starts on its own region
+        std::size_t perQueue = (chunks + queues.size() - 1) / queues.size();
+        for (std::size_t q = 0; q < queues.size(); ++q) {
+            std::lock_guard<std::mutex> lock(queues[q].mutex);
+            for (std::size_t c = q * perQueue; c < std::min(chunks, (q + 1) * perQueue); ++c) {
+                queues[q].chunks.push_front({c * chunkSize, std::min(count, (c + 1) * chunkSize)});
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            ++generation;
+        }
+        wake.notify_all();
+
+        drain(workerCount() - 1);
+        std::unique_lock<std::mutex> lock(stateMutex);
+        done.wait(lock, [this] { return remaining.load(std::memory_order_acquire) == 0; });
+    }
+
+private:
+    struct Chunk {
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    // Padded so neighbouring queues never share a cache line
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<Chunk> chunks;
+    };
+
+    void workerLoop(unsigned index) {
+        HMI_TRACE_THREAD("pool worker");
+        std::uint64_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(stateMutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) {
+                    return;
+                }
+                seen = generation;
+            }
+            drain(index);
+        }
+    }
+
+    void drain(unsigned self) {
+        Chunk chunk;
+        while (popLocal(self, chunk) || steal(self, chunk)) {
+            jobInvoke(jobContext, chunk.begin, chunk.end, self);
+            if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                done.notify_all();
+            }
+        }
+    }
+
+    bool popLocal(unsigned self, Chunk& chunk) {
+        Queue& queue = queues[self];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.chunks.empty()) {
+            return false;
+        }
+        chunk = queue.chunks.back();
+        queue.chunks.pop_back();
+        return true;
+    }
+
+    bool steal(unsigned self, Chunk& chunk) {
+        for (std::size_t offset = 1; offset < queues.size(); ++offset) {
+            Queue& victim = queues[(self + offset) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.chunks.empty()) {
+                chunk = victim.chunks.front();
+                victim.chunks.pop_front();
+                stealCount.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<Queue> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex callMutex;      // one parallelFor at a time
+    void* jobContext = nullptr;
+    void (*jobInvoke)(void*, std::size_t, std::size_t, unsigned) = nullptr;
+    std::atomic<std::size_t> remaining{0};
+    std::atomic<std::uint64_t> stealCount{0};
+
+    std::mutex stateMutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::uint64_t generation = 0;
+    bool stopping = false;
+};
+
+#endif // WORK_STEALING_POOL_H
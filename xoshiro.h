@@ -0,0 +1,96 @@
+#ifndef XOSHIRO_H
+#define XOSHIRO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+// xoshiro256++ by Blackman and Vigna: 32 bytes of state, a handful of
+// instructions per 64-bit output and good statistical quality, so every
+// thread can own one. It satisfies UniformRandomBitGenerator and can still be
+// handed to the std:: distributions where exactness matters.
+class Xoshiro256 {
+public:
+    using result_type = std::uint64_t;
+
+    explicit Xoshiro256(std::uint64_t seed = 0x9e3779b97f4a7c15ULL) {
+        // splitmix64 spreads a single seed over the whole state
+        for (auto& word : state) {
+            seed += 0x9e3779b97f4a7c15ULL;
+            std::uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        std::uint64_t result = rotl(state[0] + state[3], 23) + state[0];
+        std::uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    // Advance by 2^128 outputs; generators jumped 1, 2, 3... times from the
+    // same seed produce non-overlapping streams, one per thread
+    void jump() {
+        static constexpr std::uint64_t polynomial[] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                                       0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+        std::uint64_t jumped[4] = {0, 0, 0, 0};
+        for (std::uint64_t word : polynomial) {
+            for (int bit = 0; bit < 64; ++bit) {
+                if (word & (1ULL << bit)) {
+                    for (int i = 0; i < 4; ++i) {
+                        jumped[i] ^= state[i];
+                    }
+                }
+                (*this)();
+            }
+        }
+        for (int i = 0; i < 4; ++i) {
+            state[i] = jumped[i];
+        }
+    }
+
+    // Integer in [min, max] by multiply-shift on 32 random bits. There is no
+    // rejection step, so a range of n values is biased by at most n / 2^32,
+    // far below anything a simulation can notice.
+    std::int32_t range(std::int32_t min, std::int32_t max) {
+        return scale(static_cast<std::uint32_t>((*this)() >> 32), min, max);
+    }
+
+    // Fill out with count integers in [min, max], two per 64-bit output
+    void fillRange(std::int32_t* out, std::size_t count, std::int32_t min, std::int32_t max) {
+        std::size_t i = 0;
+        for (; i + 1 < count; i += 2) {
+            std::uint64_t bits = (*this)();
+            out[i] = scale(static_cast<std::uint32_t>(bits), min, max);
+            out[i + 1] = scale(static_cast<std::uint32_t>(bits >> 32), min, max);
+        }
+        if (i < count) {
+            out[i] = range(min, max);
+        }
+    }
+
+private:
+    static std::uint64_t rotl(std::uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    static std::int32_t scale(std::uint32_t bits, std::int32_t min, std::int32_t max) {
+        std::uint64_t span = static_cast<std::uint64_t>(static_cast<std::int64_t>(max) - min) + 1;
+        return static_cast<std::int32_t>(min + static_cast<std::int64_t>((bits * span) >> 32));
+    }
+
+    std::uint64_t state[4];
+};
+
+#endif // XOSHIRO_H